@@ -0,0 +1,162 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_BINARYIO_H_
+#define COMMON_BINARYIO_H_
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Native-endian binary streams for the precompiled model image and the
+ * runtime snapshots. Arrays are stored as a 64-bit element count followed
+ * by the elements, both aligned to 8 bytes, so that a reader over a
+ * memory-mapped file can hand out pointers into the mapping.
+ */
+class BinaryWriter {
+private:
+    ostream& os;
+    uint64_t offset;
+
+    void pad() {
+        static const char zeros[8] = { 0 };
+        if (offset % 8) {
+            write(zeros, 8 - offset % 8);
+        }
+    }
+public:
+    BinaryWriter(ostream& os) : os(os), offset(0) {}
+
+    void write(const void* data, size_t size) {
+        os.write((const char*) data, size);
+        offset += size;
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(is_trivially_copyable<T>::value, "POD values only");
+        write(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void putArray(const T* data, size_t count) {
+        static_assert(is_trivially_copyable<T>::value, "POD arrays only");
+        pad();
+        put<uint64_t>(count);
+        write(data, count * sizeof(T));
+        pad();
+    }
+
+    template <typename T>
+    void putArray(const vector<T>& values) {
+        putArray(values.data(), values.size());
+    }
+
+    void putString(const string& value) {
+        putArray(value.data(), value.size());
+    }
+
+    bool good() const {
+        return os.good();
+    }
+};
+
+class BinaryReader {
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+    bool failed;
+
+    void align() {
+        offset = (offset + 7) & ~(size_t) 7;
+    }
+
+    const char* take(size_t n) {
+        if (failed || n > size || offset > size - n) {
+            failed = true;
+            return nullptr;
+        }
+        const char* p = data + offset;
+        offset += n;
+        return p;
+    }
+public:
+    BinaryReader(const void* data, size_t size) :
+            data((const char*) data), size(size), offset(0), failed(false) {}
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(is_trivially_copyable<T>::value, "POD values only");
+        const char* p = take(sizeof(T));
+        if (p) {
+            memcpy(&value, p, sizeof(T));
+        }
+        return p != nullptr;
+    }
+
+    /*
+     * Point into the underlying buffer without copying. The element type
+     * must not need more than 8-byte alignment.
+     */
+    template <typename T>
+    bool view(const T*& values, size_t& count) {
+        static_assert(alignof(T) <= 8, "over-aligned arrays");
+        uint64_t n = 0;
+        align();
+        if (!get(n) || n > size / sizeof(T)) {
+            failed = true;
+            return false;
+        }
+        const char* p = take(n * sizeof(T));
+        align();
+        values = (const T*) p;
+        count = n;
+        return p != nullptr;
+    }
+
+    template <typename T>
+    bool getArray(vector<T>& values) {
+        const T* p = nullptr;
+        size_t n = 0;
+        if (!view(p, n)) {
+            return false;
+        }
+        values.assign(p, p + n);
+        return true;
+    }
+
+    bool getString(string& value) {
+        const char* p = nullptr;
+        size_t n = 0;
+        if (!view(p, n)) {
+            return false;
+        }
+        value.assign(p, n);
+        return true;
+    }
+
+    bool good() const {
+        return !failed;
+    }
+};
+
+#endif /* COMMON_BINARYIO_H_ */
@@ -0,0 +1,144 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_CALENDARQUEUE_H_
+#define COMMON_CALENDARQUEUE_H_
+
+#include <omnetpp.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Priority queue of timed entries over a calendar of buckets (Brown 1988).
+ *
+ * Each bucket covers one day of the given width, and the calendar wraps
+ * around after a year of numBuckets days. With the width set to the usual
+ * spacing of the entries and the year to their usual horizon, push is O(1)
+ * and finding the next entry touches a few buckets. Entries of the same
+ * time are handed out in insertion order. Times must not be negative.
+ */
+template <typename T>
+class CalendarQueue {
+private:
+    struct Entry {
+        int64_t time;
+        T value;
+    };
+    vector<vector<Entry>> buckets;
+    size_t mask;
+    // raw width of a day
+    int64_t width;
+    size_t count;
+    // no entry is on an earlier day
+    int64_t day;
+
+    int64_t dayOf(int64_t time) const {
+        return time / width;
+    }
+    vector<Entry>& bucketOf(int64_t time) {
+        return buckets[(size_t) dayOf(time) & mask];
+    }
+public:
+    CalendarQueue() : buckets(1), mask(0), width(1), count(0), day(0) {}
+
+    /*
+     * Empty the queue and lay out numBuckets days, rounded up to a power
+     * of two, of the given width.
+     */
+    void reset(size_t numBuckets, simtime_t width) {
+        size_t n = 1;
+        while (n < numBuckets) {
+            n <<= 1;
+        }
+        buckets.assign(n, vector<Entry>());
+        mask = n - 1;
+        this->width = width.raw() > 0 ? width.raw() : 1;
+        count = 0;
+        day = 0;
+    }
+
+    void push(simtime_t time, const T& value) {
+        int64_t t = time.raw();
+        if (count == 0 || dayOf(t) < day) {
+            day = dayOf(t);
+        }
+        bucketOf(t).push_back({ t, value });
+        count++;
+    }
+
+    /*
+     * Time of the earliest entry, precondition: !empty()
+     */
+    simtime_t peekTime() {
+        for (size_t i = 0; i <= mask; i++, day++) {
+            bool found = false;
+            int64_t best = 0;
+            for (auto& entry : buckets[(size_t) day & mask]) {
+                if (dayOf(entry.time) == day && (!found || entry.time < best)) {
+                    best = entry.time;
+                    found = true;
+                }
+            }
+            if (found) {
+                return SimTime::fromRaw(best);
+            }
+        }
+
+        // a whole year without entries, jump to the earliest one
+        bool found = false;
+        int64_t best = 0;
+        for (auto& bucket : buckets) {
+            for (auto& entry : bucket) {
+                if (!found || entry.time < best) {
+                    best = entry.time;
+                    found = true;
+                }
+            }
+        }
+        day = dayOf(best);
+        return SimTime::fromRaw(best);
+    }
+
+    /*
+     * Move all entries of the given time to out, in insertion order
+     */
+    void popAll(simtime_t time, vector<T>& out) {
+        int64_t t = time.raw();
+        vector<Entry>& bucket = bucketOf(t);
+        size_t kept = 0;
+        for (size_t i = 0; i < bucket.size(); i++) {
+            if (bucket[i].time == t) {
+                out.push_back(bucket[i].value);
+            } else {
+                bucket[kept++] = bucket[i];
+            }
+        }
+        count -= bucket.size() - kept;
+        bucket.erase(bucket.begin() + kept, bucket.end());
+    }
+
+    size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+#endif /* COMMON_CALENDARQUEUE_H_ */
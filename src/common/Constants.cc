@@ -16,7 +16,10 @@
 #include "Constants.h"
 
 const char* msg::IOT_EVENT = "IOT_EVENT";
+const char* msg::IOT_EVENT_BATCH = "IOT_EVENT_BATCH";
 const char* msg::SIM_EVENT = "SIM_EVENT";
+const char* msg::SIM_EVENT_BATCH = "SIM_EVENT_BATCH";
 const char* msg::EG_TIMEOUT = "EG_TIMEOUT";
 const char* msg::SE_TIMEOUT = "SE_TIMEOUT";
 const char* msg::SC_TIMEOUT = "SC_TIMEOUT";
+const char* msg::SOCKET_DATA = "SOCKET_DATA";
@@ -23,8 +23,12 @@ namespace msg {
      */
     // physical operation event
     extern const char* IOT_EVENT;
+    // batch of physical operation events
+    extern const char* IOT_EVENT_BATCH;
     // virtual operation event
     extern const char* SIM_EVENT;
+    // batch of virtual operation events
+    extern const char* SIM_EVENT_BATCH;
     /*
      * timeout event names
      */
@@ -34,6 +38,24 @@ namespace msg {
     extern const char* SE_TIMEOUT;
     // situation check timeout
     extern const char* SC_TIMEOUT;
+    // data received by the real-time scheduler
+    extern const char* SOCKET_DATA;
+}
+
+namespace kind {
+    /*
+     * message kinds, handleMessage dispatches on these instead of the names
+     */
+    enum {
+        IOT_EVENT = 1,
+        IOT_EVENT_BATCH,
+        SIM_EVENT,
+        SIM_EVENT_BATCH,
+        EG_TIMEOUT,
+        SE_TIMEOUT,
+        SC_TIMEOUT,
+        SOCKET_DATA
+    };
 }
 
 
@@ -0,0 +1,50 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_LOGGING_H_
+#define COMMON_LOGGING_H_
+
+#include <iostream>
+
+/*
+ * Console log levels. Statements above DT_LOG_LEVEL are removed at compile
+ * time, operands included, so a release build pays nothing for them.
+ *
+ *   LOG_INFO  << ...;  time slices
+ *   LOG_DEBUG << ...;  single events and situation transitions
+ *   LOG_TRACE << ...;  queue and operation set dumps
+ *
+ * Longer dumps are guarded with if (DT_LOG_ENABLED(DT_LOG_TRACE)) { ... }.
+ */
+#define DT_LOG_NONE   0
+#define DT_LOG_INFO   1
+#define DT_LOG_DEBUG  2
+#define DT_LOG_TRACE  3
+
+// everything by default, see makefrag for the release build
+#ifndef DT_LOG_LEVEL
+#define DT_LOG_LEVEL DT_LOG_TRACE
+#endif
+
+#define DT_LOG_ENABLED(level) ((level) <= DT_LOG_LEVEL)
+
+// the empty branch keeps the macro safe inside an unbraced if/else
+#define DT_LOG(level) if (!DT_LOG_ENABLED(level)) {} else std::cout
+
+#define LOG_INFO  DT_LOG(DT_LOG_INFO)
+#define LOG_DEBUG DT_LOG(DT_LOG_DEBUG)
+#define LOG_TRACE DT_LOG(DT_LOG_TRACE)
+
+#endif /* COMMON_LOGGING_H_ */
@@ -0,0 +1,54 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_MAPPEDFILE_H_
+#define COMMON_MAPPEDFILE_H_
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+/*
+ * Read-only memory mapping of a whole file, unmapped on destruction.
+ */
+class MappedFile {
+private:
+    const void* base;
+    size_t length;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#endif
+public:
+    MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    // map a file, return false if it cannot be opened or mapped
+    bool open(const string& filename);
+    void close();
+    const void* data() const {
+        return base;
+    }
+    size_t size() const {
+        return length;
+    }
+    bool isOpen() const {
+        return base != nullptr;
+    }
+    virtual ~MappedFile();
+};
+
+#endif /* COMMON_MAPPEDFILE_H_ */
@@ -0,0 +1,110 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_MESSAGEPOOL_H_
+#define COMMON_MESSAGEPOOL_H_
+
+#include <omnetpp.h>
+#include <algorithm>
+#include <vector>
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Implemented by modules that pool the messages they send, so that the
+ * receiving module can hand a consumed message back to its sender.
+ */
+class MessagePoolOwner {
+public:
+    // take back a message sent by this module, or delete it
+    virtual void recycle(cMessage* msg) = 0;
+    virtual ~MessagePoolOwner() {}
+};
+
+/*
+ * Free list of messages of one type, owned by the sending module.
+ *
+ * get() hands out a recycled message if there is one, with only its name
+ * and kind reset, so the caller has to set every field. Messages coming
+ * back beyond the capacity are deleted.
+ */
+template <typename T>
+class MessagePool: public cNoncopyableOwnedObject {
+private:
+    vector<T*> items;
+    size_t capacity;
+public:
+    MessagePool(const char* name = nullptr, size_t capacity = 4096) :
+            cNoncopyableOwnedObject(name), capacity(capacity) {}
+
+    T* get(const char* name, short kind) {
+        if (items.empty()) {
+            return new T(name, kind);
+        }
+        T* msg = items.back();
+        items.pop_back();
+        // hand over to the calling module
+        drop(msg);
+        msg->setName(name);
+        msg->setKind(kind);
+        return msg;
+    }
+
+    void release(T* msg) {
+        if (items.size() >= capacity) {
+            delete msg;
+            return;
+        }
+        take(msg);
+        items.push_back(msg);
+    }
+
+    // allocate messages ahead of use, up to the capacity
+    void reserve(size_t n) {
+        n = min(n, capacity);
+        while (items.size() < n) {
+            T* msg = new T();
+            take(msg);
+            items.push_back(msg);
+        }
+    }
+
+    size_t size() const {
+        return items.size();
+    }
+
+    virtual ~MessagePool() {
+        for (auto msg : items) {
+            dropAndDelete(msg);
+        }
+    }
+};
+
+/*
+ * Give a consumed message back to its sender's pool, or delete it if the
+ * sender does not pool messages (or lives in another partition).
+ */
+inline void recycleMessage(cMessage* msg) {
+    MessagePoolOwner* owner = dynamic_cast<MessagePoolOwner*>(
+            msg->getSenderModule());
+    if (owner && !msg->isSelfMessage()) {
+        owner->recycle(msg);
+    } else {
+        delete msg;
+    }
+}
+
+#endif /* COMMON_MESSAGEPOOL_H_ */
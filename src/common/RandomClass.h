@@ -16,22 +16,71 @@
 #ifndef COMMON_RANDOMCLASS_H_
 #define COMMON_RANDOMCLASS_H_
 
-#include <stdlib.h>     /* srand, rand */
-#include <time.h>       /* time */
+#include <cstdint>
 
+/*
+ * xoshiro256** stream (Blackman and Vigna), one per user instead of the
+ * process-wide rand(). A stream is seeded explicitly, usually from the
+ * owning module's OMNeT++ RNG, so that runs are reproducible with the
+ * configured seed-N-mt and independent streams never share state.
+ * NextDecimal hands out doubles from a block generated in one tight loop.
+ */
 class RandomClass {
+private:
+    static const int BLOCK = 64;
+
+    uint64_t s[4];
+    double block[BLOCK];
+    int next;
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t nextInt() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void fill() {
+        for (int i = 0; i < BLOCK; i++) {
+            // upper 53 bits, uniform in [0, 1)
+            block[i] = (nextInt() >> 11) * 0x1.0p-53;
+        }
+        next = 0;
+    }
 public:
-    RandomClass() {
-        /* initialize random seed: */
-        srand(time(0));
+    RandomClass(uint64_t seed = 0) {
+        Seed(seed);
+    }
+
+    /*
+     * Restart the stream, any seed including 0 is valid
+     */
+    void Seed(uint64_t seed) {
+        // expand the seed with splitmix64, so that s is never all zero
+        for (int i = 0; i < 4; i++) {
+            uint64_t z = (seed += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            s[i] = z ^ (z >> 31);
+        }
+        next = BLOCK;
     }
 
     double NextDecimal() {
-        double r = ((double) rand() / (RAND_MAX));
-        return r;
+        if (next == BLOCK) {
+            fill();
+        }
+        return block[next++];
     }
 };
 
-RandomClass Random;
-
 #endif /* COMMON_RANDOMCLASS_H_ */
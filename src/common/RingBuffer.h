@@ -0,0 +1,160 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_RINGBUFFER_H_
+#define COMMON_RINGBUFFER_H_
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+using namespace std;
+
+/*
+ * FIFO over a circular array with O(1) push_back and pop_front.
+ *
+ * A buffer with a capacity never holds more elements than that, push_back
+ * on a full buffer is the caller's decision (see full()). A buffer without
+ * capacity (0) grows by doubling.
+ */
+template <typename T>
+class RingBuffer {
+private:
+    vector<T> items;
+    size_t head;
+    size_t count;
+    size_t capacity;
+
+    void grow() {
+        size_t size = items.empty() ? 8 : items.size() * 2;
+        vector<T> grown(size);
+        for (size_t i = 0; i < count; i++) {
+            grown[i] = (*this)[i];
+        }
+        items.swap(grown);
+        head = 0;
+    }
+public:
+    class const_iterator {
+    private:
+        const RingBuffer* buffer;
+        size_t i;
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator(const RingBuffer* buffer, size_t i) : buffer(buffer), i(i) {}
+        const T& operator*() const {
+            return (*buffer)[i];
+        }
+        const T* operator->() const {
+            return &(*buffer)[i];
+        }
+        const_iterator& operator++() {
+            i++;
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const {
+            return i == other.i;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return i != other.i;
+        }
+    };
+
+    RingBuffer(size_t capacity = 0) : head(0), count(0), capacity(capacity) {
+        if (capacity) {
+            items.resize(capacity);
+        }
+    }
+
+    void setCapacity(size_t capacity) {
+        this->capacity = capacity;
+        while (capacity && count > capacity) {
+            pop_front();
+        }
+        if (capacity && items.size() != capacity) {
+            vector<T> resized(capacity);
+            for (size_t i = 0; i < count; i++) {
+                resized[i] = (*this)[i];
+            }
+            items.swap(resized);
+            head = 0;
+        }
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    bool full() const {
+        return capacity && count == capacity;
+    }
+
+    // precondition: !full()
+    void push_back(const T& item) {
+        if (count == items.size()) {
+            grow();
+        }
+        items[(head + count) % items.size()] = item;
+        count++;
+    }
+
+    void pop_front() {
+        head = (head + 1) % items.size();
+        count--;
+    }
+
+    T& front() {
+        return items[head];
+    }
+    const T& front() const {
+        return items[head];
+    }
+    T& back() {
+        return (*this)[count - 1];
+    }
+    const T& back() const {
+        return (*this)[count - 1];
+    }
+    T& operator[](size_t i) {
+        return items[(head + i) % items.size()];
+    }
+    const T& operator[](size_t i) const {
+        return items[(head + i) % items.size()];
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+    size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, count);
+    }
+};
+
+#endif /* COMMON_RINGBUFFER_H_ */
@@ -0,0 +1,96 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_SLICEARENA_H_
+#define COMMON_SLICEARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+using namespace std;
+
+/*
+ * Monotonic memory for the temporaries of one time slice: the reasoning
+ * result, the merged events and the operation sets. Allocation bumps a
+ * pointer into one buffer, deallocation does nothing, and reset() at the
+ * end of the slice frees it all at once.
+ *
+ * A slice that outgrows the buffer takes more from the heap, and the next
+ * reset grows the buffer to cover it, so that once the slices have reached
+ * their usual size they never touch the global heap.
+ */
+class SliceArena {
+private:
+    // heap fallback, counting what the buffer lacked
+    class Overflow: public pmr::memory_resource {
+    public:
+        size_t allocated = 0;
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            allocated += bytes;
+            return pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    Overflow overflow;
+    unique_ptr<char[]> buffer;
+    size_t capacity;
+    unique_ptr<pmr::monotonic_buffer_resource> resource;
+
+    void allocate(size_t size) {
+        resource.reset();
+        buffer.reset(new char[size]);
+        capacity = size;
+        resource.reset(new pmr::monotonic_buffer_resource(buffer.get(), size,
+                &overflow));
+    }
+public:
+    SliceArena(size_t initial = 64 * 1024) {
+        allocate(initial);
+    }
+    SliceArena(const SliceArena&) = delete;
+    SliceArena& operator=(const SliceArena&) = delete;
+
+    pmr::memory_resource* get() {
+        return resource.get();
+    }
+
+    /*
+     * Free everything allocated since the last reset, nothing allocated
+     * from the arena may be used afterwards
+     */
+    void reset() {
+        resource->release();
+        if (overflow.allocated) {
+            size_t size = capacity + overflow.allocated;
+            overflow.allocated = 0;
+            allocate(size);
+        }
+    }
+
+    // bytes a slice can take without the heap
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
+
+#endif /* COMMON_SLICEARENA_H_ */
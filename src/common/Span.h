@@ -0,0 +1,40 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_SPAN_H_
+#define COMMON_SPAN_H_
+
+#include <cstddef>
+
+/*
+ * Read-only view of a contiguous range, e.g., one row of a CSR array.
+ * It never owns the elements, so it must not outlive their container.
+ */
+template <typename T>
+class Span {
+private:
+    const T* first;
+    const T* last;
+public:
+    Span() : first(nullptr), last(nullptr) {}
+    Span(const T* first, const T* last) : first(first), last(last) {}
+    const T* begin() const { return first; }
+    const T* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    const T& operator[](size_t i) const { return first[i]; }
+};
+
+#endif /* COMMON_SPAN_H_ */
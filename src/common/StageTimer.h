@@ -0,0 +1,56 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_STAGETIMER_H_
+#define COMMON_STAGETIMER_H_
+
+#include <chrono>
+
+/*
+ * Wall-clock cost of a pipeline stage, read from the monotonic clock.
+ * A disabled timer never reads the clock and measures 0.
+ */
+class StageTimer {
+private:
+    typedef std::chrono::steady_clock Clock;
+    bool enabled;
+    Clock::time_point start;
+public:
+    StageTimer() : enabled(true) {}
+
+    void setEnabled(bool enabled) {
+        this->enabled = enabled;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    void begin() {
+        if (enabled) {
+            start = Clock::now();
+        }
+    }
+
+    // seconds since begin()
+    double end() const {
+        if (!enabled) {
+            return 0;
+        }
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+};
+
+#endif /* COMMON_STAGETIMER_H_ */
@@ -0,0 +1,139 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads) {
+    generation = 0;
+    stopping = false;
+    remaining = 0;
+    if (threads <= 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    for (int i = 0; i < threads; i++) {
+        queues.emplace_back(new Queue());
+    }
+    for (int i = 1; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this, i);
+    }
+}
+
+bool ThreadPool::pop(int self, Task*& task) {
+    {
+        Queue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    int n = queues.size();
+    for (int k = 1; k < n; k++) {
+        Queue& victim = *queues[(self + k) % n];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::drain(int self) {
+    Task* task;
+    while (pop(self, task)) {
+        try {
+            (*task)();
+        } catch (...) {
+            lock_guard<mutex> guard(lock);
+            if (!failure) {
+                failure = current_exception();
+            }
+        }
+        if (--remaining == 0) {
+            lock_guard<mutex> guard(lock);
+            done.notify_all();
+        }
+    }
+}
+
+void ThreadPool::work(int self) {
+    long seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] {
+                return stopping || generation != seen;
+            });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        drain(self);
+    }
+}
+
+void ThreadPool::run(vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    if (workers.empty()) {
+        for (auto& task : tasks) {
+            task();
+        }
+        return;
+    }
+
+    remaining = tasks.size();
+    int n = queues.size();
+    for (size_t i = 0; i < tasks.size(); i++) {
+        Queue& queue = *queues[i % n];
+        lock_guard<mutex> guard(queue.lock);
+        queue.tasks.push_back(&tasks[i]);
+    }
+    {
+        lock_guard<mutex> guard(lock);
+        generation++;
+    }
+    wake.notify_all();
+
+    drain(0);
+    exception_ptr error;
+    {
+        unique_lock<mutex> guard(lock);
+        done.wait(guard, [&] {
+            return remaining == 0;
+        });
+        error = failure;
+        failure = nullptr;
+    }
+    if (error) {
+        rethrow_exception(error);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
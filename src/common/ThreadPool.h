@@ -0,0 +1,75 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_THREADPOOL_H_
+#define COMMON_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Fixed set of worker threads for fork-join work inside one simulation
+ * event. run() deals the tasks out to per-thread deques, takes part in
+ * the work itself and returns once every task has finished. An idle
+ * thread pops from the back of its own deque and steals from the front
+ * of the others, so uneven tasks still keep all threads busy.
+ *
+ * Tasks must not touch the simulation kernel (send, emit, scheduleAt).
+ * The first exception thrown by a task is rethrown by run().
+ */
+class ThreadPool {
+public:
+    typedef function<void()> Task;
+private:
+    struct Queue {
+        mutex lock;
+        deque<Task*> tasks;
+    };
+    // queues[0] belongs to the thread calling run()
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    // bumped by run() to start the workers on a new set of tasks
+    long generation;
+    bool stopping;
+    atomic<long> remaining;
+    exception_ptr failure;
+
+    bool pop(int self, Task*& task);
+    void drain(int self);
+    void work(int self);
+public:
+    // 0 threads for one per hardware thread, 1 runs everything inline
+    explicit ThreadPool(int threads = 0);
+    int size() const {
+        return queues.size();
+    }
+    void run(vector<Task>& tasks);
+    virtual ~ThreadPool();
+};
+
+#endif /* COMMON_THREADPOOL_H_ */
@@ -0,0 +1,63 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include "TraceSink.h"
+
+static const char MAGIC[4] = { 'D', 'T', 'T', 'R' };
+
+bool TraceSink::checkHeader(const TraceHeader& header) {
+    return memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+            && header.version == VERSION && header.recordSize == sizeof(Record);
+}
+
+TraceSink::TraceSink() : out(os) {
+    active = false;
+}
+
+bool TraceSink::open(const string& filename) {
+    close();
+    os.open(filename, ios::binary | ios::trunc);
+    if (!os) {
+        return false;
+    }
+    TraceHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.recordSize = sizeof(Record);
+    header.reserved = 0;
+    out.put(header);
+    active = out.good();
+    return active;
+}
+
+void TraceSink::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), buffer.size() * sizeof(Record));
+        buffer.clear();
+    }
+}
+
+void TraceSink::close() {
+    if (!active) {
+        return;
+    }
+    flush();
+    os.close();
+    active = false;
+}
+
+TraceSink::~TraceSink() {
+    close();
+}
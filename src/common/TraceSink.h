@@ -0,0 +1,98 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_TRACESINK_H_
+#define COMMON_TRACESINK_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "BinaryIO.h"
+
+using namespace std;
+
+/*
+ * Binary trace of the synchronizer for post-hoc analysis, independent of
+ * the console log level. The file is a TraceHeader followed by fixed-size
+ * records in native byte order, see tools/sgtrace for a reader.
+ */
+class TraceSink {
+public:
+    enum Type {
+        // IoT event received, value is toTrigger
+        IOT_EVENT = 1,
+        // time slice started, value is the number of triggered situations
+        SLICE,
+        // situation in the reasoning result
+        TRIGGERED,
+        // simulation event sent, value is the operation count
+        SIM_EVENT
+    };
+
+    static const uint32_t VERSION = 1;
+
+    struct TraceHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t reserved;
+    };
+
+    struct Record {
+        // simulation time the record was taken at
+        double time;
+        // timestamp carried by the event, or the record time
+        double timestamp;
+        int64_t id;
+        int32_t type;
+        int32_t value;
+    };
+
+    static bool checkHeader(const TraceHeader& header);
+
+private:
+    ofstream os;
+    BinaryWriter out;
+    // records not yet written, flushed in blocks
+    static const size_t BLOCK = 4096;
+    vector<Record> buffer;
+    bool active;
+
+    void flush();
+
+public:
+    TraceSink();
+    bool open(const string& filename);
+    void close();
+    bool isOpen() const {
+        return active;
+    }
+    void record(Type type, double time, long id, int value) {
+        record(type, time, time, id, value);
+    }
+    void record(Type type, double time, double timestamp, long id, int value) {
+        if (!active) {
+            return;
+        }
+        buffer.push_back({ time, timestamp, id, type, value });
+        if (buffer.size() >= BLOCK) {
+            flush();
+        }
+    }
+    virtual ~TraceSink();
+};
+
+#endif /* COMMON_TRACESINK_H_ */
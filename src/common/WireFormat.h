@@ -0,0 +1,123 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef COMMON_WIREFORMAT_H_
+#define COMMON_WIREFORMAT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+/*
+ * Binary framing of IoT events from live devices, the fields of
+ * IoTEvent.msg in a fixed layout of native (little-endian) byte order.
+ *
+ * A frame is a FrameHeader followed by count records, 8-byte sized, so
+ * that frames packed back to back into an aligned buffer can be read in
+ * place. A datagram or a stream read carries any number of frames, and
+ * a frame holds up to MAX_RECORDS events.
+ */
+class WireFormat {
+public:
+    static const uint16_t VERSION = 1;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+    // records of a frame filling the largest UDP payload
+    static const uint32_t MAX_RECORDS = 2700;
+
+    struct FrameHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t recordSize;
+        uint32_t count;
+        uint32_t byteOrder;
+    };
+
+    struct Record {
+        int64_t eventID;
+        // simulation time of the event in microseconds
+        int64_t timestamp;
+        uint8_t toTrigger;
+        uint8_t reserved[7];
+    };
+
+    static_assert(sizeof(FrameHeader) == 16, "unexpected header padding");
+    static_assert(sizeof(Record) == 24, "unexpected record padding");
+
+    static bool checkHeader(const FrameHeader& header) {
+        return memcmp(header.magic, "DTEV", 4) == 0
+                && header.version == VERSION
+                && header.recordSize == sizeof(Record)
+                && header.byteOrder == BYTE_ORDER_MARK
+                && header.count <= MAX_RECORDS;
+    }
+
+    static size_t frameSize(size_t count) {
+        return sizeof(FrameHeader) + count * sizeof(Record);
+    }
+
+    // append one frame of the records to out
+    static void encode(vector<char>& out, const Record* records, size_t count) {
+        FrameHeader header;
+        memcpy(header.magic, "DTEV", 4);
+        header.version = VERSION;
+        header.recordSize = sizeof(Record);
+        header.count = count;
+        header.byteOrder = BYTE_ORDER_MARK;
+        size_t offset = out.size();
+        out.resize(offset + frameSize(count));
+        memcpy(out.data() + offset, &header, sizeof(header));
+        memcpy(out.data() + offset + sizeof(header), records,
+                count * sizeof(Record));
+    }
+
+    /*
+     * Call visit(const Record&) for each record of the complete frames at
+     * the front of data, in place, and return the bytes they take. A
+     * trailing partial frame is left for the next call. invalid is set if
+     * a header is corrupt or misaligned, the stream cannot be resumed then.
+     */
+    template <typename F>
+    static size_t decode(const char* data, size_t size, F visit,
+            bool& invalid) {
+        size_t offset = 0;
+        invalid = false;
+        while (size - offset >= sizeof(FrameHeader)) {
+            const char* frame = data + offset;
+            if ((uintptr_t) frame % alignof(Record) != 0) {
+                invalid = true;
+                break;
+            }
+            const FrameHeader& header = *(const FrameHeader*) frame;
+            if (!checkHeader(header)) {
+                invalid = true;
+                break;
+            }
+            size_t length = frameSize(header.count);
+            if (size - offset < length) {
+                break;
+            }
+            const Record* records = (const Record*) (frame + sizeof(FrameHeader));
+            for (uint32_t i = 0; i < header.count; i++) {
+                visit(records[i]);
+            }
+            offset += length;
+        }
+        return offset;
+    }
+};
+
+#endif /* COMMON_WIREFORMAT_H_ */
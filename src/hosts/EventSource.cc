@@ -14,28 +14,22 @@
 // 
 
 #include <algorithm>
-#include <boost/json.hpp>
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
 #include "../common/Constants.h"
 #include "../objects/PhysicalOperation.h"
+#include "../objects/RuntimeSnapshot.h"
 #include "../messages/IoTEvent_m.h"
+#include "../messages/IoTEventBatch_m.h"
 #include "EventSource.h"
 
 Define_Module(EventSource);
 
 EventSource::EventSource(){
-    /*
-     * Construct a situation graph and its instance
-     */
-    sa.initModel("../files/SG.json");
-
-//    sa.print();
-
     // 500 ms
     min_event_cycle = 0.5;
+    batchUplink = false;
+    eventDriven = false;
 
-    EGTimeout = new cMessage(msg::EG_TIMEOUT);
+    EGTimeout = new cMessage(msg::EG_TIMEOUT, kind::EG_TIMEOUT);
 }
 
 EventSource::~EventSource(){
@@ -45,28 +39,172 @@ EventSource::~EventSource(){
 }
 
 void EventSource::initialize() {
+    /*
+     * Construct a situation graph and its instance, the model itself is
+     * shared with all other modules loading the same file
+     */
+    ReachabilityIndex::Strategy strategy;
+    if (!ReachabilityIndex::parseStrategy(par("reachabilityIndex").stdstringValue(),
+            strategy)) {
+        throw cRuntimeError("Unknown reachability index '%s'",
+                par("reachabilityIndex").stringValue());
+    }
+    sa.initModel(par("modelFile").stringValue(), strategy,
+            par("modelImage").boolValue());
+    batchUplink = par("batchUplink").boolValue();
+    eventDriven = par("eventDriven").boolValue();
+    // a stream of its own, seeded from this module's RNG 0
+    cRNG* rng = getRNG(0);
+    uint64_t seed = rng->intRand();
+    sa.seed(seed << 32 | rng->intRand());
+    int numPartitions = par("numPartitions").intValue();
+    int partition = par("partition").intValue();
+    if (numPartitions < 1 || partition < 0 || partition >= numPartitions) {
+        throw cRuntimeError("Expected 0 <= partition < numPartitions");
+    }
+    ModelPartition::Grouping grouping;
+    if (!ModelPartition::parseGrouping(par("partitioning").stdstringValue(),
+            grouping)) {
+        throw cRuntimeError("Unknown partitioning '%s'",
+                par("partitioning").stringValue());
+    }
+    if (numPartitions > 1) {
+        sa.setPartition(ModelPartition::get(sa.getModel(), numPartitions,
+                grouping), partition);
+    }
+    sa.setEventDriven(eventDriven, min_event_cycle);
+    const CycleSchedule& schedule = sa.getSchedule();
+    if (schedule.isBuilt()) {
+        EV_INFO << "operational situations repeat every "
+                << schedule.getHyperperiod() << ", at most "
+                << schedule.peakDue() << " due per tick" << endl;
+        recordScalar("hyperperiod", schedule.getHyperperiod());
+        recordScalar("peakEventsPerTick", schedule.peakDue());
+        if (!batchUplink) {
+            eventPool.reserve(schedule.peakDue());
+        }
+    }
+    lg.configure(this);
+    lg.attach(this, "out");
+
+    snapshotFile = par("snapshotFile").stdstringValue();
+    snapshotTime = par("snapshotTime").doubleValue();
+    string restoreFile = par("restoreFile").stdstringValue();
+    if (!restoreFile.empty()) {
+        restoreSnapshot(restoreFile);
+    }
+
+//    sa.print();
 
     // schedule IoT event generation
-    scheduleAt(min_event_cycle, EGTimeout);
+    if (!eventDriven) {
+        scheduleAt(min_event_cycle, EGTimeout);
+    } else {
+        scheduleNextDue();
+    }
+}
+
+void EventSource::scheduleNextDue() {
+    simtime_t next;
+    if (sa.nextDue(next)) {
+        scheduleAt(max(next, simTime()), EGTimeout);
+    }
+}
+
+void EventSource::saveSnapshot() {
+    if (!RuntimeSnapshot::write(snapshotFile, *sa.getModel(), simTime(),
+            [this](BinaryWriter& out) {
+                sa.save(out);
+            })) {
+        throw cRuntimeError("Cannot write snapshot '%s'", snapshotFile.c_str());
+    }
+    EV_INFO << "arranger state written to " << snapshotFile << " at "
+            << simTime() << endl;
+    snapshotFile.clear();
+}
+
+void EventSource::restoreSnapshot(const string& file) {
+    simtime_t time;
+    bool restored = RuntimeSnapshot::read(file, *sa.getModel(), time,
+            [this, &time](BinaryReader& in) {
+                return sa.load(in, time);
+            });
+    if (!restored) {
+        throw cRuntimeError("Cannot restore snapshot '%s' of model '%s'",
+                file.c_str(), par("modelFile").stringValue());
+    }
+    EV_INFO << "arranger state restored from " << file << ", taken at "
+            << time << endl;
+}
+
+void EventSource::sendBatch(const vector<PhysicalOperation>& operations) {
+    if (operations.empty()) {
+        return;
+    }
+
+    /*
+     * Releases are sent as well, as single events are: the toggleCancel
+     * merge of the synchronizer cancels triggers with them
+     */
+    IoTEventBatch* batch = batchPool.get(msg::IOT_EVENT_BATCH,
+            kind::IOT_EVENT_BATCH);
+    batch->setEventsArraySize(operations.size());
+    for (size_t i = 0; i < operations.size(); i++) {
+        IoTEventRecord record;
+        record.eventID = operations[i].id;
+        record.toTrigger = operations[i].toTrigger;
+        record.timestamp = operations[i].getTimestamp();
+        batch->setEvents(i, record);
+    }
+
+    simtime_t latency = lg.generator_latency();
+    // send out the message
+    sendDelayed(batch, latency, "out");
+}
+
+void EventSource::recycle(cMessage *msg) {
+    Enter_Method_Silent();
+    switch (msg->getKind()) {
+    case kind::IOT_EVENT:
+        eventPool.release(check_and_cast<IoTEvent*>(msg));
+        break;
+    case kind::IOT_EVENT_BATCH:
+        batchPool.release(check_and_cast<IoTEventBatch*>(msg));
+        break;
+    default:
+        delete msg;
+    }
 }
 
 void EventSource::handleMessage(cMessage *msg) {
-    if (msg->isName(msg::EG_TIMEOUT)) {
+    if (msg->getKind() == kind::EG_TIMEOUT) {
 
         vector<PhysicalOperation> operations = sa.arrange(simTime());
-        for(auto operation : operations){
-            IoTEvent* event = new IoTEvent(msg::IOT_EVENT);
-
-            event->setEventID(operation.id);
-            event->setToTrigger(operation.toTrigger);
-            event->setTimestamp(operation.timestamp);
+        if (batchUplink) {
+            sendBatch(operations);
+        } else {
+            for (auto& operation : operations) {
+                IoTEvent* event = eventPool.get(msg::IOT_EVENT,
+                        kind::IOT_EVENT);
 
-            simtime_t latency = lg.generator_latency();
-            // send out the message
-            sendDelayed(event, latency, "out");
+                event->setEventID(operation.id);
+                event->setToTrigger(operation.toTrigger);
+                event->setTimestamp(operation.getTimestamp());
 
+                simtime_t latency = lg.generator_latency();
+                // send out the message
+                sendDelayed(event, latency, "out");
+            }
         }
 
-        scheduleAt(simTime() + min_event_cycle, EGTimeout);
+        lg.refill();
+        if (!snapshotFile.empty() && simTime() >= snapshotTime) {
+            saveSnapshot();
+        }
+        if (!eventDriven) {
+            scheduleAt(simTime() + min_event_cycle, EGTimeout);
+        } else {
+            scheduleNextDue();
+        }
     }
 }
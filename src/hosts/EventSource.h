@@ -19,6 +19,9 @@
 #include <omnetpp.h>
 #include <map>
 #include <vector>
+#include "../common/MessagePool.h"
+#include "../messages/IoTEvent_m.h"
+#include "../messages/IoTEventBatch_m.h"
 #include "../objects/SituationArranger.h"
 #include "../transport/LatencyGenerator.h"
 
@@ -28,13 +31,29 @@ using namespace omnetpp;
 /**
  *
  */
-class EventSource: public cSimpleModule {
+class EventSource: public cSimpleModule, public MessagePoolOwner {
 private:
     simtime_t min_event_cycle;
     // event generation timeout
     cMessage* EGTimeout;
     LatencyGenerator lg;
     SituationArranger sa;
+    // one batch of triggering events per tick instead of one event per operation
+    bool batchUplink;
+    // schedule at the arranger's next due time instead of every tick
+    bool eventDriven;
+    // pending snapshot, "" if none or already written
+    string snapshotFile;
+    simtime_t snapshotTime;
+
+    // recycled packets, handed back by the receiver
+    MessagePool<IoTEvent> eventPool;
+    MessagePool<IoTEventBatch> batchPool;
+
+    void sendBatch(const vector<PhysicalOperation>& operations);
+    void scheduleNextDue();
+    void saveSnapshot();
+    void restoreSnapshot(const string& file);
 
 protected:
     virtual void initialize() override;
@@ -42,6 +61,7 @@ protected:
 
 public:
     EventSource();
+    void recycle(cMessage *msg) override;
     virtual ~EventSource();
 };
 
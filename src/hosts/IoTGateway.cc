@@ -0,0 +1,187 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <cstdlib>
+#include <cstring>
+#include "../common/Constants.h"
+#include "../common/Logging.h"
+#include "IoTGateway.h"
+
+Define_Module(IoTGateway);
+
+// longest line parsed, anything longer is malformed
+static const size_t MAX_LINE = 128;
+
+IoTGateway::IoTGateway() {
+    rtScheduler = nullptr;
+    synchronizer = nullptr;
+    numBytes = 0;
+    skipping = false;
+    malformed = 0;
+
+    dataMsg = new cMessage(msg::SOCKET_DATA, kind::SOCKET_DATA);
+}
+
+IoTGateway::~IoTGateway() {
+    if (dataMsg != NULL) {
+        cancelAndDelete(dataMsg);
+    }
+}
+
+void IoTGateway::initialize() {
+    rtScheduler = dynamic_cast<SocketRTScheduler*>(
+            getSimulation()->getScheduler());
+    if (!rtScheduler) {
+        throw cRuntimeError("IoTGateway needs scheduler-class = \"SocketRTScheduler\"");
+    }
+    string format = par("format").stdstringValue();
+    if (format == "binary") {
+        synchronizer = check_and_cast<Synchronizer*>(
+                gate("out")->getPathEndGate()->getOwnerModule());
+    } else if (format != "text") {
+        throw cRuntimeError("Unknown event format '%s'", format.c_str());
+    }
+    long size = par("receiveBuffer").intValue();
+    if (size <= 0 || (synchronizer
+            && (size_t) size < WireFormat::frameSize(WireFormat::MAX_RECORDS))) {
+        throw cRuntimeError("receiveBuffer of %ld bytes cannot hold a frame",
+                size);
+    }
+    buffer.resize(size);
+    numBytes = 0;
+    rtScheduler->setInterfaceModule(this, dataMsg, buffer.data(),
+            buffer.size(), &numBytes);
+    receivedEventsSignal = registerSignal("receivedEvents");
+}
+
+bool IoTGateway::parseRecord(const char* line, const char* end,
+        IoTEventRecord& record) {
+    char text[MAX_LINE];
+    size_t length = end - line;
+    if (length >= MAX_LINE) {
+        return false;
+    }
+    memcpy(text, line, length);
+    text[length] = '\0';
+
+    char* p = text;
+    char* next;
+    record.eventID = strtol(p, &next, 10);
+    if (next == p) {
+        return false;
+    }
+    p = next;
+    long toTrigger = strtol(p, &next, 10);
+    if (next == p || (toTrigger != 0 && toTrigger != 1)) {
+        return false;
+    }
+    record.toTrigger = toTrigger;
+    p = next;
+    double timestamp = strtod(p, &next);
+    record.timestamp = next == p ? simTime() : SimTime(timestamp);
+    p = next;
+    while (*p == ' ' || *p == '\t' || *p == '\r') {
+        p++;
+    }
+    return *p == '\0';
+}
+
+void IoTGateway::recycle(cMessage *msg) {
+    Enter_Method_Silent();
+    if (msg->getKind() == kind::IOT_EVENT_BATCH) {
+        batchPool.release(check_and_cast<IoTEventBatch*>(msg));
+    } else {
+        delete msg;
+    }
+}
+
+void IoTGateway::receiveFrames() {
+    size_t events = 0;
+    bool invalid = false;
+    size_t consumed = synchronizer->ingest(buffer.data(), numBytes, events,
+            invalid);
+    if (invalid) {
+        // frame boundaries are lost, drop everything received so far
+        malformed++;
+        consumed = numBytes;
+    }
+    memmove(buffer.data(), buffer.data() + consumed, numBytes - consumed);
+    numBytes -= consumed;
+    if (events > 0) {
+        LOG_DEBUG << "received " << events << " IoT events" << endl;
+        emit(receivedEventsSignal, (long) events);
+    }
+}
+
+void IoTGateway::receiveLines() {
+    /*
+     * Parse the complete lines, and keep a partial one for the next batch
+     */
+    vector<IoTEventRecord> records;
+    const char* p = buffer.data();
+    const char* end = p + numBytes;
+    while (const char* eol = (const char*) memchr(p, '\n', end - p)) {
+        if (skipping) {
+            skipping = false;
+        } else if (eol > p && !(eol == p + 1 && *p == '\r')) {
+            IoTEventRecord record;
+            if (parseRecord(p, eol, record)) {
+                records.push_back(record);
+            } else {
+                malformed++;
+            }
+        }
+        p = eol + 1;
+    }
+    size_t rest = end - p;
+    if (rest == buffer.size()) {
+        // no line end in a full buffer
+        if (!skipping) {
+            malformed++;
+            skipping = true;
+        }
+        rest = 0;
+    }
+    memmove(buffer.data(), p, rest);
+    numBytes = rest;
+
+    if (records.empty()) {
+        return;
+    }
+    LOG_DEBUG << "received " << records.size() << " IoT events" << endl;
+    IoTEventBatch* batch = batchPool.get(msg::IOT_EVENT_BATCH,
+            kind::IOT_EVENT_BATCH);
+    batch->setEventsArraySize(records.size());
+    for (size_t i = 0; i < records.size(); i++) {
+        batch->setEvents(i, records[i]);
+    }
+    emit(receivedEventsSignal, (long) records.size());
+    // the devices' network latency has already been paid
+    send(batch, "out");
+}
+
+void IoTGateway::handleMessage(cMessage *msg) {
+    if (msg->getKind() == kind::SOCKET_DATA) {
+        if (synchronizer) {
+            receiveFrames();
+        } else {
+            receiveLines();
+        }
+    }
+}
+
+void IoTGateway::finish() {
+    recordScalar("malformedInput", malformed);
+}
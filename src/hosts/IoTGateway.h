@@ -0,0 +1,77 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __DTSYNCHRONIZER_IOTGATEWAY_H_
+#define __DTSYNCHRONIZER_IOTGATEWAY_H_
+
+#include <omnetpp.h>
+#include <vector>
+#include "../common/MessagePool.h"
+#include "../messages/IoTEventBatch_m.h"
+#include "../transport/SocketRTScheduler.h"
+#include "Synchronizer.h"
+
+using namespace omnetpp;
+using namespace std;
+
+/**
+ * Ingress of IoT events from live devices, in place of EventSource. It
+ * runs under SocketRTScheduler and turns each batch of received data
+ * into events of the synchronizer.
+ *
+ * Binary WireFormat frames are read in place straight into the cache of
+ * the synchronizer it is connected to, without any message. A frame may
+ * be split across stream reads, but not across datagrams.
+ *
+ * In text format events are lines "<eventID> <toTrigger> [<timestamp>]",
+ * with toTrigger 0 or 1 and the timestamp in simulation seconds, the
+ * arrival time if left out. A line may be split across datagrams or
+ * reads. Each batch is sent as one IoTEventBatch.
+ */
+class IoTGateway: public cSimpleModule, public MessagePoolOwner {
+private:
+    SocketRTScheduler* rtScheduler;
+    // receiver of binary frames, nullptr in text format
+    Synchronizer* synchronizer;
+    cMessage* dataMsg;
+    // received bytes, a partial line or frame is kept at the front
+    vector<char> buffer;
+    size_t numBytes;
+    // a line too long for the buffer is skipped up to its end
+    bool skipping;
+    // malformed lines, or times corrupt frames were dropped
+    long malformed;
+
+    MessagePool<IoTEventBatch> batchPool;
+    simsignal_t receivedEventsSignal;
+
+    bool parseRecord(const char* line, const char* end, IoTEventRecord& record);
+    // hand the complete frames in the buffer to the synchronizer
+    void receiveFrames();
+    // turn the complete lines in the buffer into one batch
+    void receiveLines();
+
+protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+public:
+    IoTGateway();
+    void recycle(cMessage *msg) override;
+    virtual ~IoTGateway();
+};
+
+#endif
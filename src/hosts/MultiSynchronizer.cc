@@ -0,0 +1,255 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "../common/Constants.h"
+#include "../common/Logging.h"
+#include "../messages/IoTEvent_m.h"
+#include "../messages/IoTEventBatch_m.h"
+#include "MultiSynchronizer.h"
+
+Define_Module(MultiSynchronizer);
+
+MultiSynchronizer::MultiSynchronizer() {
+    slice_cycle = 3;
+
+    SETimeout = new cMessage(msg::SE_TIMEOUT, kind::SE_TIMEOUT);
+    SCTimeout = new cMessage(msg::SC_TIMEOUT, kind::SC_TIMEOUT);
+}
+
+MultiSynchronizer::~MultiSynchronizer() {
+    if (SETimeout != NULL) {
+        cancelAndDelete(SETimeout);
+    }
+    if (SCTimeout != NULL) {
+        cancelAndDelete(SCTimeout);
+    }
+}
+
+void MultiSynchronizer::initialize() {
+    int numTwins = par("numTwins").intValue();
+    if (numTwins < 1) {
+        throw cRuntimeError("numTwins must be at least 1");
+    }
+    if (gateSize("in") != numTwins || gateSize("out") != numTwins) {
+        throw cRuntimeError("Expected %d in and out gates, one per twin",
+                numTwins);
+    }
+
+    slice_cycle = par("sliceCycle").doubleValue();
+    if (slice_cycle <= SIMTIME_ZERO) {
+        throw cRuntimeError("sliceCycle must be positive");
+    }
+
+    ReachabilityIndex::Strategy strategy;
+    if (!ReachabilityIndex::parseStrategy(par("reachabilityIndex").stdstringValue(),
+            strategy)) {
+        throw cRuntimeError("Unknown reachability index '%s'",
+                par("reachabilityIndex").stringValue());
+    }
+    // the twins already evolve in parallel
+    string engineName = par("reasoningEngine").stdstringValue();
+    if (engineName == "parallel") {
+        throw cRuntimeError("The parallel reasoning engine is not available "
+                "to twins, see numThreads");
+    }
+    OperationGenerator::MergePolicy merge;
+    if (!OperationGenerator::parseMergePolicy(
+            par("mergePolicy").stdstringValue(), merge)) {
+        throw cRuntimeError("Unknown event merge policy '%s'",
+                par("mergePolicy").stringValue());
+    }
+
+    /*
+     * One instance per twin, all of them sharing the model
+     */
+    for (int k = 0; k < numTwins; k++) {
+        unique_ptr<Twin> twin(new Twin());
+        twin->sr.initModel(par("modelFile").stringValue(), strategy,
+                par("modelImage").boolValue());
+        unique_ptr<ReasoningEngine> engine = ReasoningEngine::create(
+                engineName, *twin->sr.getModel());
+        if (!engine) {
+            throw cRuntimeError("Unknown reasoning engine '%s' for model '%s', "
+                    "compiled ones are generated with sgcompile -e",
+                    engineName.c_str(), par("modelFile").stringValue());
+        }
+        twin->sr.setEngine(move(engine));
+        twin->sog.setModel(twin->sr.getModel());
+        twin->sog.setModelInstance(&twin->sr);
+        twin->triggers.setModel(twin->sr.getModel());
+        twin->sog.setTriggerBuffer(&twin->triggers);
+        twin->sog.setMergePolicy(merge);
+        twin->sog.setCompensation(par("syncCompensation").boolValue());
+        // a single clock read per slice instead, see sliceTime
+        twin->sog.setStageTiming(false);
+        twins.push_back(move(twin));
+    }
+    pool.reset(new ThreadPool(par("numThreads").intValue()));
+    lg.configure(this);
+    lg.attach(this, "out");
+    sliceTimeSignal = registerSignal("sliceTime");
+
+    // schedule situation evolution, state checks follow the expiry deadlines
+    scheduleAt(slice_cycle, SETimeout);
+}
+
+void MultiSynchronizer::scheduleCheck() {
+    bool any = false;
+    simtime_t earliest;
+    for (auto& twin : twins) {
+        simtime_t deadline;
+        if (twin->sr.nextDeadline(deadline) && (!any || deadline < earliest)) {
+            earliest = deadline;
+            any = true;
+        }
+    }
+    if (any) {
+        // situations due now were already reset by the reasoners
+        if (earliest <= simTime()) {
+            earliest = simTime();
+        }
+        rescheduleAt(earliest, SCTimeout);
+    } else {
+        cancelEvent(SCTimeout);
+    }
+}
+
+bool MultiSynchronizer::cacheEvent(Twin& twin, const OperationalEvent& event) {
+    // the generator adds the triggers
+    return twin.sog.cacheEvent(event.id, event.toTrigger,
+            event.getTimestamp());
+}
+
+void MultiSynchronizer::receiveEvent(Twin& twin, long id, bool toTrigger,
+        simtime_t timestamp) {
+    if (toTrigger
+            || twin.sog.getMergePolicy() == OperationGenerator::TOGGLE_CANCEL) {
+        OperationalEvent event;
+        event.id = id;
+        event.toTrigger = toTrigger;
+        event.setTimestamp(timestamp);
+        if (!cacheEvent(twin, event)) {
+            twin.heldEvents.push_back(event);
+        }
+    }
+}
+
+void MultiSynchronizer::evolve(Twin& twin, simtime_t current) {
+    // release the sets of the last slice before their memory
+    twin.opSets = OperationSets(twin.arena.get());
+    twin.arena.reset();
+
+    SituationSet tOperations = twin.sr.reason(twin.triggers.drain(), current,
+            twin.arena.get());
+    twin.sog.generateOperations(tOperations, twin.opSets);
+
+    // offer held events again, in arrival order
+    pmr::vector<OperationalEvent> retry(twin.heldEvents.begin(),
+            twin.heldEvents.end(), twin.arena.get());
+    twin.heldEvents.clear();
+    for (auto& event : retry) {
+        if (!cacheEvent(twin, event)) {
+            twin.heldEvents.push_back(event);
+        }
+    }
+}
+
+void MultiSynchronizer::sendBatch(int k, const OperationSet& operations) {
+    if (operations.empty()) {
+        return;
+    }
+    Twin& twin = *twins[k];
+    SimEventBatch *batch = batchPool.get(msg::SIM_EVENT_BATCH,
+            kind::SIM_EVENT_BATCH);
+    batch->setSequence(twin.batchSequence++);
+    batch->setEventsArraySize(operations.size());
+    for (size_t i = 0; i < operations.size(); i++) {
+        SimEventRecord record;
+        record.eventID = operations[i].id;
+        record.timestamp = operations[i].getTimestamp();
+        record.count = operations[i].count;
+        record.svId = operations[i].svId;
+        batch->setEvents(i, record);
+    }
+
+    // one latency sample per batch, never overtaking the twin's previous one
+    simtime_t arrival = simTime() + lg.generator_latency();
+    if (arrival < twin.lastBatchArrival) {
+        arrival = twin.lastBatchArrival;
+    }
+    twin.lastBatchArrival = arrival;
+    sendDelayed(batch, arrival - simTime(), "out", k);
+}
+
+void MultiSynchronizer::recycle(cMessage *msg) {
+    Enter_Method_Silent();
+    if (msg->getKind() == kind::SIM_EVENT_BATCH) {
+        batchPool.release(check_and_cast<SimEventBatch*>(msg));
+    } else {
+        delete msg;
+    }
+}
+
+void MultiSynchronizer::handleMessage(cMessage *msg) {
+    if (msg->getKind() == kind::IOT_EVENT) {
+        IoTEvent *event = check_and_cast<IoTEvent*>(msg);
+        Twin& twin = *twins[msg->getArrivalGate()->getIndex()];
+        receiveEvent(twin, event->getEventID(), event->getToTrigger(),
+                event->getTimestamp());
+        recycleMessage(event);
+    } else if (msg->getKind() == kind::IOT_EVENT_BATCH) {
+        IoTEventBatch *batch = check_and_cast<IoTEventBatch*>(msg);
+        Twin& twin = *twins[msg->getArrivalGate()->getIndex()];
+        for (size_t i = 0; i < batch->getEventsArraySize(); i++) {
+            const IoTEventRecord& event = batch->getEvents(i);
+            receiveEvent(twin, event.eventID, event.toTrigger, event.timestamp);
+        }
+        recycleMessage(batch);
+    } else if (msg->getKind() == kind::SE_TIMEOUT) {
+        simtime_t current = simTime();
+
+        LOG_INFO << endl << "current time slice: " << current << endl;
+
+        /*
+         * The twins only share the immutable model, so they evolve in
+         * parallel. Sending stays on this thread, in twin order.
+         */
+        timer.begin();
+        tasks.clear();
+        for (auto& twin : twins) {
+            Twin* t = twin.get();
+            tasks.push_back([this, t, current] {
+                evolve(*t, current);
+            });
+        }
+        pool->run(tasks);
+        emit(sliceTimeSignal, timer.end());
+
+        for (size_t k = 0; k < twins.size(); k++) {
+            for (auto& operations : twins[k]->opSets) {
+                sendBatch(k, operations);
+            }
+        }
+        lg.refill();
+
+        scheduleAt(simTime() + slice_cycle, SETimeout);
+        scheduleCheck();
+    } else if (msg->getKind() == kind::SC_TIMEOUT) {
+        for (auto& twin : twins) {
+            twin->sr.checkState(simTime());
+        }
+        scheduleCheck();
+    }
+}
@@ -0,0 +1,96 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef __DTSYNCHRONIZER_MULTISYNCHRONIZER_H_
+#define __DTSYNCHRONIZER_MULTISYNCHRONIZER_H_
+
+#include <omnetpp.h>
+#include <memory>
+#include <set>
+#include <vector>
+#include "../common/MessagePool.h"
+#include "../common/SliceArena.h"
+#include "../common/StageTimer.h"
+#include "../common/ThreadPool.h"
+#include "../messages/SimEventBatch_m.h"
+#include "../objects/OperationGenerator.h"
+#include "../objects/SituationReasoner.h"
+#include "../objects/TriggerBuffer.h"
+#include "../transport/LatencyGenerator.h"
+
+using namespace std;
+using namespace omnetpp;
+
+/**
+ * Synchronizer for numTwins independent digital twins. Events arriving
+ * on in[k] belong to twin k, its simulation events leave on out[k], one
+ * SimEventBatch per operation set.
+ *
+ * Each twin owns a reasoner and an operation generator over the shared
+ * model. At every time slice their reason and generateOperations run on a
+ * thread pool, one task per twin; the results are sent afterwards in twin
+ * order, so a run does not depend on the number of threads.
+ */
+class MultiSynchronizer: public cSimpleModule, public MessagePoolOwner {
+private:
+    struct Twin {
+        SituationReasoner sr;
+        OperationGenerator sog;
+        // triggers waiting for a slice, one per situation and slice
+        TriggerBuffer triggers;
+        // events rejected by a full cache
+        vector<OperationalEvent> heldEvents;
+        // temporaries of the current slice
+        SliceArena arena;
+        // result of the last slice
+        OperationSets opSets { arena.get() };
+        long batchSequence = 0;
+        simtime_t lastBatchArrival;
+    };
+
+    // time slice
+    simtime_t slice_cycle;
+    // situation evolution timeout
+    cMessage* SETimeout;
+    // situation check timeout, at the earliest expiry of all twins
+    cMessage* SCTimeout;
+
+    vector<unique_ptr<Twin>> twins;
+    unique_ptr<ThreadPool> pool;
+    vector<ThreadPool::Task> tasks;
+    LatencyGenerator lg;
+    MessagePool<SimEventBatch> batchPool;
+    // wall-clock cost of the parallel part of a slice
+    StageTimer timer;
+    simsignal_t sliceTimeSignal;
+
+    bool cacheEvent(Twin& twin, const OperationalEvent& event);
+    void receiveEvent(Twin& twin, long id, bool toTrigger, simtime_t timestamp);
+    // reason and generate the operations of one twin, on a pool thread
+    void evolve(Twin& twin, simtime_t current);
+    void sendBatch(int k, const OperationSet& operations);
+    void scheduleCheck();
+
+protected:
+    virtual void initialize() override;
+    virtual void handleMessage(cMessage *msg) override;
+
+public:
+    MultiSynchronizer();
+    void recycle(cMessage *msg) override;
+    virtual ~MultiSynchronizer();
+};
+
+#endif
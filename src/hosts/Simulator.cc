@@ -14,24 +14,172 @@
 // 
 
 #include "../common/Constants.h"
+#include "../common/Logging.h"
+#include "../common/MessagePool.h"
 #include "../messages/SimEvent_m.h"
+#include "../messages/SimEventBatch_m.h"
 #include "Simulator.h"
 
 Define_Module(Simulator);
 
 void Simulator::initialize() {
-    // TODO - Generated method body
+    version = 0;
+    appliedOperations = 0;
+    staleOperations = 0;
+    reorderedBatches = 0;
+    applyTime = 0;
+    syncLagSignal = registerSignal("syncLag");
+    applyTimeSignal = registerSignal("applyTime");
+    batchSizeSignal = registerSignal("batchSize");
+    syncErrorSignal = registerSignal("syncError");
+    syncLags.setName("syncLags");
+}
+
+void Simulator::collectLag(simtime_t lag) {
+    emit(syncLagSignal, lag);
+    // as the statistics, after the warmup only
+    if (simTime() >= getSimulation()->getWarmupPeriod()) {
+        syncLags.collect(lag);
+    }
+}
+
+// q-quantile of the histogram, interpolated within its bin
+static double quantile(cHistogram& histogram, double q) {
+    if (!histogram.binsAlreadySetUp()) {
+        histogram.setUpBins();
+    }
+    double target = q * histogram.getSumWeights();
+    double seen = histogram.getUnderflowSumWeights();
+    if (seen >= target) {
+        return histogram.getMin();
+    }
+    for (int k = 0; k < histogram.getNumBins(); k++) {
+        double weight = histogram.getBinValue(k);
+        if (weight > 0 && seen + weight >= target) {
+            double low = histogram.getBinEdge(k);
+            double high = histogram.getBinEdge(k + 1);
+            return low + (high - low) * (target - seen) / weight;
+        }
+        seen += weight;
+    }
+    return histogram.getMax();
+}
+
+void Simulator::stage(const Update& update) {
+    if (update.svId < 0) {
+        throw cRuntimeError("Simulation event (%ld) for invalid state variable %d",
+                update.id, update.svId);
+    }
+    if ((size_t) update.svId >= store.size()) {
+        store.resize(update.svId + 1);
+    }
+    StateVariable& sv = store[update.svId];
+    if (sv.version > 0 && update.timestamp < sv.timestamp) {
+        // stale, the variable is already past this update
+        emit(syncErrorSignal, sv.timestamp - update.timestamp);
+        staleOperations++;
+        return;
+    }
+    if (sv.stagedBy == version + 1) {
+        // the set updates the variable twice, the newer update wins
+        Update& other = staged[sv.slot];
+        if (update.timestamp < other.timestamp) {
+            emit(syncErrorSignal, other.timestamp - update.timestamp);
+            staleOperations++;
+        } else {
+            other = update;
+        }
+        return;
+    }
+    sv.stagedBy = version + 1;
+    sv.slot = staged.size();
+    staged.push_back(update);
+}
+
+void Simulator::commit() {
+    // nothing of the set is applied, no new version
+    if (staged.empty()) {
+        return;
+    }
+    version++;
+    for (auto& update : staged) {
+        StateVariable& sv = store[update.svId];
+        sv.id = update.id;
+        sv.count = update.count;
+        sv.timestamp = update.timestamp;
+        sv.version = version;
+    }
+    appliedOperations += staged.size();
+    emit(batchSizeSignal, (long) staged.size());
+    staged.clear();
 }
 
 void Simulator::handleMessage(cMessage *msg) {
-    if (msg->isName(msg::SIM_EVENT)) {
+    if (msg->getKind() == kind::SIM_EVENT) {
         SimEvent *event = check_and_cast<SimEvent*>(msg);
 
-        cout << "Simulation event (" << event->getEventID() << "): timestamp "
+        LOG_DEBUG << "Simulation event (" << event->getEventID() << "): timestamp "
                 << event->getTimestamp() << " count " << event->getCount()
                 << endl;
+        collectLag(simTime() - event->getTimestamp());
+
+        timer.begin();
+        stage(Update { event->getEventID(), event->getTimestamp(),
+                event->getCount(), event->getSvId() });
+        commit();
+        double cost = timer.end();
+        applyTime += cost;
+        emit(applyTimeSignal, cost);
+
+        // hand the received msg back to its sender
+        recycleMessage(event);
+    } else if (msg->getKind() == kind::SIM_EVENT_BATCH) {
+        SimEventBatch *batch = check_and_cast<SimEventBatch*>(msg);
 
-        // delete the received msg
-        delete event;
+        int sender = batch->getSenderModuleId();
+        auto last = lastSequence.find(sender);
+        if (last != lastSequence.end() && batch->getSequence() < last->second) {
+            reorderedBatches++;
+        } else {
+            lastSequence[sender] = batch->getSequence();
+        }
+
+        timer.begin();
+        for (size_t i = 0; i < batch->getEventsArraySize(); i++) {
+            const SimEventRecord& event = batch->getEvents(i);
+            LOG_DEBUG << "Simulation event (" << event.eventID << "): timestamp "
+                    << event.timestamp << " count " << event.count << endl;
+            collectLag(simTime() - event.timestamp);
+            stage(Update { event.eventID, event.timestamp, event.count,
+                    event.svId });
+        }
+        // the operation set is applied as a whole
+        commit();
+        double cost = timer.end();
+        applyTime += cost;
+        emit(applyTimeSignal, cost);
+
+        recycleMessage(batch);
+    } else {
+        LOG_INFO << "Simulator: dropping message of unknown kind "
+                << msg->getKind() << endl;
+        recycleMessage(msg);
+    }
+}
+
+void Simulator::finish() {
+    recordScalar("appliedOperations", appliedOperations);
+    recordScalar("appliedBatches", version);
+    recordScalar("staleOperations", staleOperations);
+    recordScalar("reorderedBatches", reorderedBatches);
+    recordScalar("stateVariables", store.size());
+    if (applyTime > 0) {
+        recordScalar("applyThroughput", appliedOperations / applyTime, "ops/s");
+    }
+    if (syncLags.getCount() > 0) {
+        recordScalar("syncLag:p50", quantile(syncLags, 0.5), "s");
+        recordScalar("syncLag:p90", quantile(syncLags, 0.9), "s");
+        recordScalar("syncLag:p99", quantile(syncLags, 0.99), "s");
+        recordScalar("syncLag:p999", quantile(syncLags, 0.999), "s");
     }
 }
@@ -17,18 +17,77 @@
 #define __DTSYNCHRONIZER_SIMULATOR_H_
 
 #include <omnetpp.h>
+#include <map>
+#include <vector>
+#include "../common/StageTimer.h"
 
 using namespace omnetpp;
 using namespace std;
 
 /**
- * TODO - Generated class
+ * Simulator endpoint keeping the state each state variable was last
+ * synchronized to.
+ *
+ * The store is dense, indexed by the svId of the operations. An operation
+ * set sent as one SimEventBatch is applied atomically: all its updates are
+ * validated first, then committed with one version, so the store never
+ * reflects part of a set. Single SimEvents carry no set boundary, so each
+ * is committed as a version of its own. An update older than the state it
+ * would replace is a sync error and is not applied. A batch or event that
+ * leaves nothing to apply, empty or all stale, commits no version.
  */
 class Simulator : public cSimpleModule
 {
+  private:
+    struct StateVariable {
+        // situation the variable was last set by, -1 if never
+        long id = -1;
+        // counter of the situation instance
+        int count = 0;
+        simtime_t timestamp;
+        // batch that last changed the variable, 0 if never
+        long version = 0;
+        // slot in the staged updates, valid while stagedBy is the batch
+        int slot = 0;
+        long stagedBy = 0;
+    };
+    struct Update {
+        long id;
+        simtime_t timestamp;
+        int count;
+        int svId;
+    };
+
+    vector<StateVariable> store;
+    // updates of the batch being applied
+    vector<Update> staged;
+    // number of batches applied, those that changed the store
+    long version;
+    // last batch sequence per sender, to detect reordered batches
+    map<int, long> lastSequence;
+
+    // totals for the scalars
+    long appliedOperations;
+    long staleOperations;
+    long reorderedBatches;
+    double applyTime;
+
+    StageTimer timer;
+    // end-to-end lag from the event timestamp to its receipt here, also
+    // collected for the percentile scalars
+    simsignal_t syncLagSignal;
+    cHistogram syncLags;
+    simsignal_t applyTimeSignal;
+    simsignal_t batchSizeSignal;
+    simsignal_t syncErrorSignal;
+
+    void stage(const Update& update);
+    void collectLag(simtime_t lag);
+    void commit();
   protected:
     virtual void initialize() override;
     virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
 };
 
 #endif
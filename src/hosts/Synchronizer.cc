@@ -14,28 +14,28 @@
 // 
 
 #include "../common/Constants.h"
+#include "../common/Logging.h"
 #include "../common/Util.h"
 #include "../messages/IoTEvent_m.h"
+#include "../messages/IoTEventBatch_m.h"
 #include "../messages/SimEvent_m.h"
+#include "../messages/SimEventBatch_m.h"
+#include "../objects/RuntimeSnapshot.h"
 #include "Synchronizer.h"
 
 Define_Module(Synchronizer);
 
 Synchronizer::Synchronizer() {
-    /*
-     * Construct a situation graph and a situation inference engine
-     */
-    sr.initModel("../files/SG.json");
-    sog.setModel(sr.getModel());
-    sog.setModelInstance(&sr);
+    batchSimEvents = true;
+    batchSequence = 0;
+    reorderEvents = false;
+    watermark = -1;
+    rtScheduler = nullptr;
+    receivedEvents = 0;
+    slices = 0;
 
-    // 500 ms
-    check_cycle = 0.5;
-    // 3000 ms
-    slice_cycle = 3;
-
-    SETimeout = new cMessage(msg::SE_TIMEOUT);
-    SCTimeout = new cMessage(msg::SC_TIMEOUT);
+    SETimeout = new cMessage(msg::SE_TIMEOUT, kind::SE_TIMEOUT);
+    SCTimeout = new cMessage(msg::SC_TIMEOUT, kind::SC_TIMEOUT);
 }
 
 Synchronizer::~Synchronizer() {
@@ -48,85 +48,463 @@ Synchronizer::~Synchronizer() {
 }
 
 void Synchronizer::initialize() {
-    // schedule situation evolution
-    scheduleAt(check_cycle, SCTimeout);
-    scheduleAt(slice_cycle, SETimeout);
+    /*
+     * Construct a situation graph and a situation inference engine, the
+     * model itself is shared with all other modules loading the same file
+     */
+    ReachabilityIndex::Strategy strategy;
+    if (!ReachabilityIndex::parseStrategy(par("reachabilityIndex").stdstringValue(),
+            strategy)) {
+        throw cRuntimeError("Unknown reachability index '%s'",
+                par("reachabilityIndex").stringValue());
+    }
+    sr.initModel(par("modelFile").stringValue(), strategy,
+            par("modelImage").boolValue());
+    unique_ptr<ReasoningEngine> engine = ReasoningEngine::create(
+            par("reasoningEngine").stdstringValue(), *sr.getModel(),
+            par("reasoningThreads").intValue(),
+            par("reasoningGrain").intValue());
+    if (!engine) {
+        throw cRuntimeError("Unknown reasoning engine '%s' for model '%s', "
+                "compiled ones are generated with sgcompile -e",
+                par("reasoningEngine").stringValue(),
+                par("modelFile").stringValue());
+    }
+    sr.setEngine(move(engine));
+    sog.setModel(sr.getModel());
+    sog.setModelInstance(&sr);
+    triggers.setModel(sr.getModel());
+    sog.setTriggerBuffer(&triggers);
+    // simulator endpoints own a partition of the operational situations each
+    lastBatchArrival.assign(gateSize("out"), 0);
+    if (gateSize("out") > 1) {
+        endpoints = ModelPartition::get(sr.getModel(), gateSize("out"));
+    }
+
+    OperationGenerator::OverflowPolicy policy;
+    if (!OperationGenerator::parseOverflowPolicy(
+            par("eventQueueOverflow").stdstringValue(), policy)) {
+        throw cRuntimeError("Unknown event queue overflow policy '%s'",
+                par("eventQueueOverflow").stringValue());
+    }
+    sog.setQueueCapacity(par("eventQueueCapacity").intValue(), policy);
+
+    OperationGenerator::MergePolicy merge;
+    if (!OperationGenerator::parseMergePolicy(
+            par("mergePolicy").stdstringValue(), merge)) {
+        throw cRuntimeError("Unknown event merge policy '%s'",
+                par("mergePolicy").stringValue());
+    }
+    sog.setMergePolicy(merge);
+    sog.setCompensation(par("syncCompensation").boolValue());
+    batchSimEvents = par("batchSimEvents").boolValue();
+    reorderEvents = par("reorderEvents").boolValue();
+    allowedLateness = par("allowedLateness").doubleValue();
+    if (allowedLateness < SIMTIME_ZERO) {
+        throw cRuntimeError("allowedLateness must not be negative");
+    }
+    lg.configure(this);
+    lg.attach(this, "out");
+
+    timer.setEnabled(par("stageTiming").boolValue());
+    sog.setStageTiming(timer.isEnabled());
+    cacheTimeSignal = registerSignal("cacheTime");
+    reasonTimeSignal = registerSignal("reasonTime");
+    mergeTimeSignal = registerSignal("mergeTime");
+    sortTimeSignal = registerSignal("sortTime");
+    sendTimeSignal = registerSignal("sendTime");
+    queuedEventsSignal = registerSignal("queuedEvents");
+    bufferedTriggersSignal = registerSignal("bufferedTriggers");
+    heldEventsSignal = registerSignal("heldEvents");
+    reorderedEventsSignal = registerSignal("reorderedEvents");
+    rtScheduler = dynamic_cast<SocketRTScheduler*>(
+            getSimulation()->getScheduler());
+    sliceOverrunSignal = registerSignal("sliceOverrun");
+    sliceIntervalSignal = registerSignal("sliceInterval");
+    lateEventSignal = registerSignal("lateEvent");
+
+    simtime_t cycle = par("sliceCycle").doubleValue();
+    if (cycle <= SIMTIME_ZERO) {
+        throw cRuntimeError("sliceCycle must be positive");
+    }
+    if (par("adaptiveSlicing").boolValue()) {
+        simtime_t minimum = par("minSliceCycle").doubleValue();
+        simtime_t maximum = par("maxSliceCycle").doubleValue();
+        if (minimum <= SIMTIME_ZERO || maximum < minimum) {
+            throw cRuntimeError("Expected 0 < minSliceCycle <= maxSliceCycle");
+        }
+        slicer.setAdaptive(cycle, minimum, maximum,
+                par("sliceEvents").intValue());
+    } else {
+        slicer.setFixed(cycle);
+    }
+    // the slice cost feeds the adaptive length and the live budget check
+    sliceTimer.setEnabled(rtScheduler != nullptr || slicer.isAdaptive());
+
+    string traceFile = par("traceFile").stdstringValue();
+    if (!traceFile.empty() && !trace.open(traceFile)) {
+        throw cRuntimeError("Cannot open trace file '%s'", traceFile.c_str());
+    }
+
+    snapshotFile = par("snapshotFile").stdstringValue();
+    snapshotTime = par("snapshotTime").doubleValue();
+    string restoreFile = par("restoreFile").stdstringValue();
+    if (!restoreFile.empty()) {
+        restoreSnapshot(restoreFile);
+    }
+
+    // schedule situation evolution, state checks follow the expiry deadlines
+    scheduleAt(slicer.getInterval(), SETimeout);
+    runTimer.begin();
 }
 
-void Synchronizer::handleMessage(cMessage *msg) {
-    if (msg->isName(msg::IOT_EVENT)) {
-        IoTEvent *event = check_and_cast<IoTEvent*>(msg);
+void Synchronizer::scheduleCheck() {
+    simtime_t deadline;
+    if (sr.nextDeadline(deadline)) {
+        // situations due now were already reset by the reasoner
+        if (deadline <= simTime()) {
+            deadline = simTime();
+        }
+        rescheduleAt(deadline, SCTimeout);
+    } else {
+        cancelEvent(SCTimeout);
+    }
+}
 
-        cout << "IoT event (" << event->getEventID() << "): toTrigger "
-                << event->getToTrigger() << ", timestamp "
-                << event->getTimestamp() << endl;
+bool Synchronizer::cacheEvent(const OperationalEvent& event) {
+    timer.begin();
+    bool cached = bufferEvent(event);
+    if (timer.isEnabled()) {
+        emit(cacheTimeSignal, timer.end());
+    }
+    return cached;
+}
 
-        /*
-         * By rights, all received IoT events needs to be cached for regression if needed.
-         * Here, temporarily only triggering events are maintained for simplicity.
-         */
-        if (event->getToTrigger()) {
-            sog.cacheEvent(event->getEventID(), event->getToTrigger(),
-                    event->getTimestamp());
+bool Synchronizer::bufferEvent(const OperationalEvent& event) {
+    // the generator adds the triggers, a release may cancel an earlier one
+    return sog.cacheEvent(event.id, event.toTrigger, event.getTimestamp());
+}
 
-            long id = event->getEventID();
-            if (bufferCounters.count(id)) {
-                bufferCounters[id]++;
-            } else {
-                bufferCounters[id] = 1;
-            }
+void Synchronizer::admitEvent(const OperationalEvent& event) {
+    if (!cacheEvent(event)) {
+        // the cache is full, hold the event until the next slice
+        heldEvents.push_back(event);
+    }
+}
+
+void Synchronizer::receiveEvent(long id, bool toTrigger, simtime_t timestamp) {
+    LOG_DEBUG << "IoT event (" << id << "): toTrigger " << toTrigger
+            << ", timestamp " << timestamp << endl;
+    slicer.countArrival();
+    receivedEvents++;
+    trace.record(TraceSink::IOT_EVENT, simTime().dbl(), timestamp.dbl(), id,
+            toTrigger);
+
+    OperationalEvent event;
+    event.id = id;
+    event.toTrigger = toTrigger;
+    event.setTimestamp(timestamp);
+
+    /*
+     * A late event goes to the next slice, the slices it falls into are
+     * not reasoned about again. Only triggering events are cached for
+     * reasoning, unless releases are needed to cancel triggers in the
+     * merge.
+     */
+    bool late = timestamp <= watermark;
+    if (late) {
+        emit(lateEventSignal, watermark - timestamp);
+    }
+    if (toTrigger || sog.getMergePolicy() == OperationGenerator::TOGGLE_CANCEL) {
+        if (reorderEvents && !late) {
+            reorder.push(event);
+        } else {
+            admitEvent(event);
         }
+    }
+}
 
-        // free up memory space
-        delete event;
-    } else if (msg->isName(msg::SE_TIMEOUT)) {
+size_t Synchronizer::ingest(const char* data, size_t size, size_t& events,
+        bool& invalid) {
+    Enter_Method_Silent();
+    events = 0;
+    return WireFormat::decode(data, size,
+            [this, &events](const WireFormat::Record& record) {
+                // rounded to the simtime resolution
+                receiveEvent(record.eventID, record.toTrigger != 0,
+                        SimTime(record.timestamp / 1e6));
+                events++;
+            }, invalid);
+}
 
-        simtime_t current = simTime();
+void Synchronizer::reportOverrun(simtime_t current, double cost) {
+    // a late start counts against the budget as well
+    double elapsed = rtScheduler->getLag() + cost;
+    double budget = slicer.getInterval().dbl() * rtScheduler->getScaling();
+    if (elapsed > budget) {
+        emit(sliceOverrunSignal, elapsed - budget);
+        EV_WARN << "slice at " << current << " overran its " << budget
+                << " s budget by " << elapsed - budget << " s" << endl;
+    }
+}
 
-        cout << endl << "current time slice: " << current << endl;
+void Synchronizer::saveSnapshot() {
+    bool written = RuntimeSnapshot::write(snapshotFile, *sr.getModel(),
+            simTime(), [this](BinaryWriter& out) {
+                sr.save(out);
+                sog.save(out);
+                triggers.save(out);
+                out.putArray(heldEvents);
+                out.putArray(reorder.events());
+            });
+    if (!written) {
+        throw cRuntimeError("Cannot write snapshot '%s'", snapshotFile.c_str());
+    }
+    EV_INFO << "synchronizer state written to " << snapshotFile << " at "
+            << simTime() << endl;
+    snapshotFile.clear();
+}
+
+void Synchronizer::restoreSnapshot(const string& file) {
+    simtime_t time;
+    bool restored = RuntimeSnapshot::read(file, *sr.getModel(), time,
+            [this, &time](BinaryReader& in) {
+                vector<OperationalEvent> reordered;
+                if (!sr.load(in, time) || !sog.load(in, time)
+                        || !triggers.load(in) || !in.getArray(heldEvents)
+                        || !in.getArray(reordered)) {
+                    return false;
+                }
+                for (auto& event : heldEvents) {
+                    event.setTimestamp(event.getTimestamp() - time);
+                }
+                reorder.clear();
+                for (auto& event : reordered) {
+                    event.setTimestamp(event.getTimestamp() - time);
+                    reorder.push(event);
+                }
+                return true;
+            });
+    if (!restored) {
+        throw cRuntimeError("Cannot restore snapshot '%s' of model '%s'",
+                file.c_str(), par("modelFile").stringValue());
+    }
+    EV_INFO << "synchronizer state restored from " << file << ", taken at "
+            << time << endl;
+}
+
+int Synchronizer::endpointOf(long id) const {
+    if (!endpoints) {
+        return 0;
+    }
+    int index = sr.getModel()->indexOf(id);
+    return index == -1 ? 0 : max(endpoints->getPartitionOf(index), 0);
+}
 
-        set<long> triggered;
+void Synchronizer::sendBatch(const OperationSet& operations) {
+    if (operations.empty()) {
+        return;
+    }
 
-//        cout << "print buffer counters: ";
-//        util::printMap(bufferCounters);
+    /*
+     * Operations of a set may belong to the simulators of several out gates,
+     * each gate gets one batch of its operations, kept in set order
+     */
+    int gates = lastBatchArrival.size();
+    batchEndpoints.resize(operations.size());
+    batchCounts.assign(gates, 0);
+    for (size_t i = 0; i < operations.size(); i++) {
+        batchEndpoints[i] = endpointOf(operations[i].id);
+        batchCounts[batchEndpoints[i]]++;
+    }
 
-        for (auto bufferCounter : bufferCounters) {
-            if (bufferCounter.second > 0) {
-                triggered.insert(bufferCounter.first);
-                bufferCounters[bufferCounter.first]--;
+    for (int k = 0; k < gates; k++) {
+        if (batchCounts[k] == 0) {
+            continue;
+        }
+        SimEventBatch *batch = batchPool.get(msg::SIM_EVENT_BATCH,
+                kind::SIM_EVENT_BATCH);
+        batch->setSequence(batchSequence++);
+        batch->setEventsArraySize(batchCounts[k]);
+        size_t j = 0;
+        for (size_t i = 0; i < operations.size(); i++) {
+            if (batchEndpoints[i] != k) {
+                continue;
             }
+            SimEventRecord record;
+            record.eventID = operations[i].id;
+            record.timestamp = operations[i].getTimestamp();
+            record.count = operations[i].count;
+            record.svId = operations[i].svId;
+            batch->setEvents(j++, record);
+        }
+
+        // one latency sample per batch, never overtaking the gate's previous one
+        simtime_t arrival = simTime() + lg.generator_latency();
+        if (arrival < lastBatchArrival[k]) {
+            arrival = lastBatchArrival[k];
         }
+        lastBatchArrival[k] = arrival;
+        sendDelayed(batch, arrival - simTime(), "out", k);
+    }
+}
+
+void Synchronizer::recycle(cMessage *msg) {
+    Enter_Method_Silent();
+    switch (msg->getKind()) {
+    case kind::SIM_EVENT:
+        eventPool.release(check_and_cast<SimEvent*>(msg));
+        break;
+    case kind::SIM_EVENT_BATCH:
+        batchPool.release(check_and_cast<SimEventBatch*>(msg));
+        break;
+    default:
+        delete msg;
+    }
+}
+
+void Synchronizer::handleMessage(cMessage *msg) {
+    if (msg->getKind() == kind::IOT_EVENT) {
+        IoTEvent *event = check_and_cast<IoTEvent*>(msg);
+
+        receiveEvent(event->getEventID(), event->getToTrigger(),
+                event->getTimestamp());
+
+        // hand the message back to its sender
+        recycleMessage(event);
+    } else if (msg->getKind() == kind::IOT_EVENT_BATCH) {
+        IoTEventBatch *batch = check_and_cast<IoTEventBatch*>(msg);
+
+        for (size_t i = 0; i < batch->getEventsArraySize(); i++) {
+            const IoTEventRecord& event = batch->getEvents(i);
+            receiveEvent(event.eventID, event.toTrigger, event.timestamp);
+        }
+
+        recycleMessage(batch);
+    } else if (msg->getKind() == kind::SE_TIMEOUT) {
+
+        simtime_t current = simTime();
+        sliceTimer.begin();
+        slices++;
+        // nothing of the last slice is left to use its memory
+        arena.reset();
+
+        LOG_INFO << endl << "current time slice: " << current << endl;
+
+        // events are taken by the slice their timestamp falls into, once
+        // the watermark has passed it
+        if (reorderEvents) {
+            emit(reorderedEventsSignal, (long) reorder.size());
+            watermark = current - allowedLateness;
+            reorder.release(watermark, [this](const OperationalEvent& event) {
+                admitEvent(event);
+            });
+        }
+
+        long buffered = triggers.size();
+        Span<int> triggered = triggers.drain();
+        // triggers left for later slices
+        bool backlog = !triggers.empty();
+        emit(queuedEventsSignal, (long) sog.queuedEvents());
+        emit(bufferedTriggersSignal, buffered);
+        emit(heldEventsSignal, (long) heldEvents.size());
 
         /*
          * The reasoning result contains a list of triggered observable situations,
          * which is supposed to tell SOG to generate the corresponding simulation events.
          */
-        set<long> tOperations = sr.reason(triggered, current);
-
-        queue<vector<VirtualOperation>> opSets = sog.generateOperations(
-                tOperations);
-
-        cout << "Operation sets are: " << endl;
-        util::printComplexQueue(opSets);
-
-        while (!opSets.empty()) {
-            vector<VirtualOperation> operations = opSets.front();
-            for (auto op : operations) {
-                SimEvent *event = new SimEvent(msg::SIM_EVENT);
-                event->setEventID(op.id);
-                event->setTimestamp(op.timestamp);
-                event->setCount(op.count);
-                simtime_t latency = lg.generator_latency();
-                // send out the message
-                sendDelayed(event, latency, "out");
+        timer.begin();
+        SituationSet tOperations = sr.reason(triggered, current, arena.get());
+        if (!reorderEvents) {
+            watermark = current;
+        }
+        if (timer.isEnabled()) {
+            emit(reasonTimeSignal, timer.end());
+        }
+
+        if (trace.isOpen()) {
+            trace.record(TraceSink::SLICE, current.dbl(), -1, triggered.size());
+            for (auto id : tOperations) {
+                trace.record(TraceSink::TRIGGERED, current.dbl(), id, 0);
+            }
+        }
+
+        OperationSets opSets(arena.get());
+        sog.generateOperations(tOperations, opSets);
+        if (timer.isEnabled()) {
+            emit(mergeTimeSignal, sog.getMergeTime());
+            emit(sortTimeSignal, sog.getSortTime());
+        }
+
+        // offer held events again, in arrival order
+        pmr::vector<OperationalEvent> retry(heldEvents.begin(),
+                heldEvents.end(), arena.get());
+        heldEvents.clear();
+        for (auto& event : retry) {
+            if (!cacheEvent(event)) {
+                heldEvents.push_back(event);
             }
+        }
 
-            opSets.pop();
+        LOG_TRACE << "Operation sets are: " << endl;
+
+        timer.begin();
+        for (auto& operations : opSets) {
+            if (DT_LOG_ENABLED(DT_LOG_TRACE)) {
+                util::printContainer(operations);
+                cout << endl;
+            }
+            if (trace.isOpen()) {
+                for (auto& op : operations) {
+                    trace.record(TraceSink::SIM_EVENT, current.dbl(),
+                            op.getTimestamp().dbl(), op.id, op.count);
+                }
+            }
+            if (batchSimEvents) {
+                sendBatch(operations);
+            } else {
+                for (auto& op : operations) {
+                    SimEvent *event = eventPool.get(msg::SIM_EVENT,
+                            kind::SIM_EVENT);
+                    event->setEventID(op.id);
+                    event->setTimestamp(op.getTimestamp());
+                    event->setCount(op.count);
+                    event->setSvId(op.svId);
+                    simtime_t latency = lg.generator_latency();
+                    // send out the message
+                    sendDelayed(event, latency, "out", endpointOf(op.id));
+                }
+            }
         }
+        if (timer.isEnabled()) {
+            emit(sendTimeSignal, timer.end());
+        }
+        double cost = sliceTimer.end();
+        simtime_t interval = slicer.next(current,
+                backlog || !heldEvents.empty(), cost);
+        emit(sliceIntervalSignal, interval);
+        if (rtScheduler) {
+            reportOverrun(current, cost);
+        }
+        lg.refill();
+        if (!snapshotFile.empty() && current >= snapshotTime) {
+            saveSnapshot();
+        }
+
+        scheduleAt(simTime() + interval, SETimeout);
+        scheduleCheck();
+    } else if (msg->getKind() == kind::SC_TIMEOUT) {
+        sr.checkState(simTime());
+        scheduleCheck();
+    }
+}
 
-        scheduleAt(simTime() + slice_cycle, SETimeout);
-    } else if (msg->isName(msg::SC_TIMEOUT)) {
-        sr.checkState(SimTime());
-        scheduleAt(simTime() + check_cycle, SCTimeout);
+void Synchronizer::finish() {
+    trace.close();
+    recordScalar("receivedEvents", receivedEvents);
+    recordScalar("slices", slices);
+    double elapsed = runTimer.end();
+    if (elapsed > 0) {
+        recordScalar("eventThroughput", receivedEvents / elapsed, "events/s");
     }
 }
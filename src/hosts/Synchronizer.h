@@ -17,10 +17,23 @@
 #define __DTSYNCHRONIZER_SYNCHRONIZER_H_
 
 #include <omnetpp.h>
+#include <memory>
 
+#include "../common/MessagePool.h"
+#include "../common/SliceArena.h"
+#include "../common/StageTimer.h"
+#include "../common/TraceSink.h"
+#include "../common/WireFormat.h"
+#include "../messages/SimEvent_m.h"
+#include "../messages/SimEventBatch_m.h"
+#include "../objects/ModelPartition.h"
 #include "../objects/OperationGenerator.h"
+#include "../objects/ReorderBuffer.h"
 #include "../objects/SituationReasoner.h"
+#include "../objects/SliceController.h"
+#include "../objects/TriggerBuffer.h"
 #include "../transport/LatencyGenerator.h"
+#include "../transport/SocketRTScheduler.h"
 
 using namespace omnetpp;
 using namespace std;
@@ -28,29 +41,103 @@ using namespace std;
 /**
  * TODO - Generated class
  */
-class Synchronizer: public cSimpleModule {
+class Synchronizer: public cSimpleModule, public MessagePoolOwner {
 private:
-    // cycle to check durable situations
-    simtime_t check_cycle;
-    // time slice
-    simtime_t slice_cycle;
+    // length of the time slices, fixed or adaptive
+    SliceController slicer;
     // situation evolution timeout
     cMessage* SETimeout;
-    // situation check timeout
+    // situation check timeout, scheduled at the next expiry deadline
     cMessage* SCTimeout;
 
     SituationReasoner sr;
     OperationGenerator sog;
     LatencyGenerator lg;
-    // <situation_ID, trigger_counter>
-    map<long, int> bufferCounters;
+    // triggers waiting for a slice, one per situation and slice
+    TriggerBuffer triggers;
+    // events rejected by a full cache
+    vector<OperationalEvent> heldEvents;
+    // events waiting for the watermark, if reordering
+    ReorderBuffer reorder;
+    bool reorderEvents;
+    simtime_t allowedLateness;
+    // events up to this timestamp were handed to a slice already
+    simtime_t watermark;
+    simsignal_t lateEventSignal;
+    // temporaries of the current slice
+    SliceArena arena;
+    // send each operation set as one SimEventBatch per out gate
+    bool batchSimEvents;
+    long batchSequence;
+    // arrival of the last batch on each out gate
+    vector<simtime_t> lastBatchArrival;
+    // out gate of each operation of a set, and operations per gate
+    vector<int> batchEndpoints;
+    vector<int> batchCounts;
+    // split of the operational situations between the out gates
+    shared_ptr<const ModelPartition> endpoints;
+    // recycled packets, handed back by the simulator
+    MessagePool<SimEvent> eventPool;
+    MessagePool<SimEventBatch> batchPool;
+    // binary trace, only written if traceFile is set
+    TraceSink trace;
+    // pending snapshot, "" if none or already written
+    string snapshotFile;
+    simtime_t snapshotTime;
+
+    // wall-clock cost of the pipeline stages and queue depths
+    StageTimer timer;
+    simsignal_t cacheTimeSignal;
+    simsignal_t reasonTimeSignal;
+    simsignal_t mergeTimeSignal;
+    simsignal_t sortTimeSignal;
+    simsignal_t sendTimeSignal;
+    simsignal_t queuedEventsSignal;
+    simsignal_t bufferedTriggersSignal;
+    simsignal_t heldEventsSignal;
+    simsignal_t reorderedEventsSignal;
+    // the real-time scheduler, if running live, and the slice budget check
+    SocketRTScheduler* rtScheduler;
+    StageTimer sliceTimer;
+    simsignal_t sliceOverrunSignal;
+    simsignal_t sliceIntervalSignal;
+    // totals for the scalars, the throughput over the wall clock of the run
+    long receivedEvents;
+    long slices;
+    StageTimer runTimer;
+
+    // cache a triggering event and count it for reasoning, timed
+    bool cacheEvent(const OperationalEvent& event);
+    bool bufferEvent(const OperationalEvent& event);
+    // cache an event, or hold it if the cache is full
+    void admitEvent(const OperationalEvent& event);
+    // log a received IoT event and cache it, or hold it if the cache is full
+    void receiveEvent(long id, bool toTrigger, simtime_t timestamp);
+    void scheduleCheck();
+    // out gate of the simulator endpoint of an operational situation
+    int endpointOf(long id) const;
+    // one SimEventBatch per out gate with operations of the set
+    void sendBatch(const OperationSet& operations);
+    // warn if a live slice took longer than the slice cycle of wall clock
+    void reportOverrun(simtime_t current, double cost);
+    void saveSnapshot();
+    void restoreSnapshot(const string& file);
 
 protected:
     virtual void initialize() override;
     virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
 
 public:
     Synchronizer();
+    void recycle(cMessage *msg) override;
+    /*
+     * Cache the events of the complete WireFormat frames at the front of
+     * data, read in place, and return the bytes consumed; events is set
+     * to their number.
+     */
+    size_t ingest(const char* data, size_t size, size_t& events,
+            bool& invalid);
     virtual ~Synchronizer();
 };
 
@@ -0,0 +1,916 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.0 from messages/IoTEventBatch.msg.
+//
+
+// Disable warnings about unused variables, empty switch stmts, etc:
+#ifdef _MSC_VER
+#  pragma warning(disable:4101)
+#  pragma warning(disable:4065)
+#endif
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wshadow"
+#  pragma clang diagnostic ignored "-Wconversion"
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+#  pragma clang diagnostic ignored "-Wc++98-compat"
+#  pragma clang diagnostic ignored "-Wunreachable-code-break"
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#elif defined(__GNUC__)
+#  pragma GCC diagnostic ignored "-Wshadow"
+#  pragma GCC diagnostic ignored "-Wconversion"
+#  pragma GCC diagnostic ignored "-Wunused-parameter"
+#  pragma GCC diagnostic ignored "-Wold-style-cast"
+#  pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
+#  pragma GCC diagnostic ignored "-Wfloat-conversion"
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <type_traits>
+#include "IoTEventBatch_m.h"
+
+namespace omnetpp {
+
+// Template pack/unpack rules. They are declared *after* a1l type-specific pack functions for multiple reasons.
+// They are in the omnetpp namespace, to allow them to be found by argument-dependent lookup via the cCommBuffer argument
+
+// Packing/unpacking an std::vector
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::vector<T,A>& v)
+{
+    int n = v.size();
+    doParsimPacking(buffer, n);
+    for (int i = 0; i < n; i++)
+        doParsimPacking(buffer, v[i]);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::vector<T,A>& v)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    v.resize(n);
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(buffer, v[i]);
+}
+
+// Packing/unpacking an std::list
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::list<T,A>& l)
+{
+    doParsimPacking(buffer, (int)l.size());
+    for (typename std::list<T,A>::const_iterator it = l.begin(); it != l.end(); ++it)
+        doParsimPacking(buffer, (T&)*it);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::list<T,A>& l)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        l.push_back(T());
+        doParsimUnpacking(buffer, l.back());
+    }
+}
+
+// Packing/unpacking an std::set
+template<typename T, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::set<T,Tr,A>& s)
+{
+    doParsimPacking(buffer, (int)s.size());
+    for (typename std::set<T,Tr,A>::const_iterator it = s.begin(); it != s.end(); ++it)
+        doParsimPacking(buffer, *it);
+}
+
+template<typename T, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::set<T,Tr,A>& s)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        T x;
+        doParsimUnpacking(buffer, x);
+        s.insert(x);
+    }
+}
+
+// Packing/unpacking an std::map
+template<typename K, typename V, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::map<K,V,Tr,A>& m)
+{
+    doParsimPacking(buffer, (int)m.size());
+    for (typename std::map<K,V,Tr,A>::const_iterator it = m.begin(); it != m.end(); ++it) {
+        doParsimPacking(buffer, it->first);
+        doParsimPacking(buffer, it->second);
+    }
+}
+
+template<typename K, typename V, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::map<K,V,Tr,A>& m)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        K k; V v;
+        doParsimUnpacking(buffer, k);
+        doParsimUnpacking(buffer, v);
+        m[k] = v;
+    }
+}
+
+// Default pack/unpack function for arrays
+template<typename T>
+void doParsimArrayPacking(omnetpp::cCommBuffer *b, const T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimPacking(b, t[i]);
+}
+
+template<typename T>
+void doParsimArrayUnpacking(omnetpp::cCommBuffer *b, T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(b, t[i]);
+}
+
+// Default rule to prevent compiler from choosing base class' doParsimPacking() function
+template<typename T>
+void doParsimPacking(omnetpp::cCommBuffer *, const T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimPacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+template<typename T>
+void doParsimUnpacking(omnetpp::cCommBuffer *, T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimUnpacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+}  // namespace omnetpp
+
+IoTEventRecord::IoTEventRecord()
+{
+}
+
+void __doPacking(omnetpp::cCommBuffer *b, const IoTEventRecord& a)
+{
+    doParsimPacking(b,a.eventID);
+    doParsimPacking(b,a.toTrigger);
+    doParsimPacking(b,a.timestamp);
+}
+
+void __doUnpacking(omnetpp::cCommBuffer *b, IoTEventRecord& a)
+{
+    doParsimUnpacking(b,a.eventID);
+    doParsimUnpacking(b,a.toTrigger);
+    doParsimUnpacking(b,a.timestamp);
+}
+
+class IoTEventRecordDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_eventID,
+        FIELD_toTrigger,
+        FIELD_timestamp,
+    };
+  public:
+    IoTEventRecordDescriptor();
+    virtual ~IoTEventRecordDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(IoTEventRecordDescriptor)
+
+IoTEventRecordDescriptor::IoTEventRecordDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(IoTEventRecord)), "")
+{
+    propertyNames = nullptr;
+}
+
+IoTEventRecordDescriptor::~IoTEventRecordDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool IoTEventRecordDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<IoTEventRecord *>(obj)!=nullptr;
+}
+
+const char **IoTEventRecordDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *IoTEventRecordDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int IoTEventRecordDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 3+base->getFieldCount() : 3;
+}
+
+unsigned int IoTEventRecordDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_eventID
+        FD_ISEDITABLE,    // FIELD_toTrigger
+        FD_ISEDITABLE,    // FIELD_timestamp
+    };
+    return (field >= 0 && field < 3) ? fieldTypeFlags[field] : 0;
+}
+
+const char *IoTEventRecordDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "eventID",
+        "toTrigger",
+        "timestamp",
+    };
+    return (field >= 0 && field < 3) ? fieldNames[field] : nullptr;
+}
+
+int IoTEventRecordDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "eventID") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "toTrigger") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "timestamp") == 0) return baseIndex + 2;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *IoTEventRecordDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "long",    // FIELD_eventID
+        "bool",    // FIELD_toTrigger
+        "omnetpp::simtime_t",    // FIELD_timestamp
+    };
+    return (field >= 0 && field < 3) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **IoTEventRecordDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *IoTEventRecordDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int IoTEventRecordDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+void IoTEventRecordDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'IoTEventRecord'", field);
+    }
+}
+
+const char *IoTEventRecordDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string IoTEventRecordDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: return long2string(pp->eventID);
+        case FIELD_toTrigger: return bool2string(pp->toTrigger);
+        case FIELD_timestamp: return simtime2string(pp->timestamp);
+        default: return "";
+    }
+}
+
+void IoTEventRecordDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: pp->eventID = string2long(value); break;
+        case FIELD_toTrigger: pp->toTrigger = string2bool(value); break;
+        case FIELD_timestamp: pp->timestamp = string2simtime(value); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventRecord'", field);
+    }
+}
+
+omnetpp::cValue IoTEventRecordDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: return (omnetpp::intval_t)(pp->eventID);
+        case FIELD_toTrigger: return pp->toTrigger;
+        case FIELD_timestamp: return pp->timestamp.dbl();
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'IoTEventRecord' as cValue -- field index out of range?", field);
+    }
+}
+
+void IoTEventRecordDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: pp->eventID = omnetpp::checked_int_cast<long>(value.intValue()); break;
+        case FIELD_toTrigger: pp->toTrigger = value.boolValue(); break;
+        case FIELD_timestamp: pp->timestamp = value.doubleValue(); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventRecord'", field);
+    }
+}
+
+const char *IoTEventRecordDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr IoTEventRecordDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void IoTEventRecordDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventRecord *pp = omnetpp::fromAnyPtr<IoTEventRecord>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventRecord'", field);
+    }
+}
+
+Register_Class(IoTEventBatch)
+
+IoTEventBatch::IoTEventBatch(const char *name, short kind) : ::omnetpp::cPacket(name, kind)
+{
+}
+
+IoTEventBatch::IoTEventBatch(const IoTEventBatch& other) : ::omnetpp::cPacket(other)
+{
+    copy(other);
+}
+
+IoTEventBatch::~IoTEventBatch()
+{
+    delete [] this->events;
+}
+
+IoTEventBatch& IoTEventBatch::operator=(const IoTEventBatch& other)
+{
+    if (this == &other) return *this;
+    ::omnetpp::cPacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void IoTEventBatch::copy(const IoTEventBatch& other)
+{
+    delete [] this->events;
+    this->events = (other.events_arraysize==0) ? nullptr : new IoTEventRecord[other.events_arraysize];
+    events_arraysize = other.events_arraysize;
+    for (size_t i = 0; i < events_arraysize; i++) {
+        this->events[i] = other.events[i];
+    }
+}
+
+void IoTEventBatch::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cPacket::parsimPack(b);
+    b->pack(events_arraysize);
+    doParsimArrayPacking(b,this->events,events_arraysize);
+}
+
+void IoTEventBatch::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cPacket::parsimUnpack(b);
+    delete [] this->events;
+    b->unpack(events_arraysize);
+    if (events_arraysize == 0) {
+        this->events = nullptr;
+    } else {
+        this->events = new IoTEventRecord[events_arraysize];
+        doParsimArrayUnpacking(b,this->events,events_arraysize);
+    }
+}
+
+size_t IoTEventBatch::getEventsArraySize() const
+{
+    return events_arraysize;
+}
+
+const IoTEventRecord& IoTEventBatch::getEvents(size_t k) const
+{
+    if (k >= events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    return this->events[k];
+}
+
+void IoTEventBatch::setEventsArraySize(size_t newSize)
+{
+    IoTEventRecord *events2 = (newSize==0) ? nullptr : new IoTEventRecord[newSize];
+    size_t minSize = events_arraysize < newSize ? events_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        events2[i] = this->events[i];
+    delete [] this->events;
+    this->events = events2;
+    events_arraysize = newSize;
+}
+
+void IoTEventBatch::setEvents(size_t k, const IoTEventRecord& events)
+{
+    if (k >= events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    this->events[k] = events;
+}
+
+void IoTEventBatch::insertEvents(size_t k, const IoTEventRecord& events)
+{
+    if (k > events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    size_t newSize = events_arraysize + 1;
+    IoTEventRecord *events2 = new IoTEventRecord[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        events2[i] = this->events[i];
+    events2[k] = events;
+    for (i = k + 1; i < newSize; i++)
+        events2[i] = this->events[i-1];
+    delete [] this->events;
+    this->events = events2;
+    events_arraysize = newSize;
+}
+
+void IoTEventBatch::appendEvents(const IoTEventRecord& events)
+{
+    insertEvents(events_arraysize, events);
+}
+
+void IoTEventBatch::eraseEvents(size_t k)
+{
+    if (k >= events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    size_t newSize = events_arraysize - 1;
+    IoTEventRecord *events2 = (newSize == 0) ? nullptr : new IoTEventRecord[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        events2[i] = this->events[i];
+    for (i = k; i < newSize; i++)
+        events2[i] = this->events[i+1];
+    delete [] this->events;
+    this->events = events2;
+    events_arraysize = newSize;
+}
+
+class IoTEventBatchDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_events,
+    };
+  public:
+    IoTEventBatchDescriptor();
+    virtual ~IoTEventBatchDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(IoTEventBatchDescriptor)
+
+IoTEventBatchDescriptor::IoTEventBatchDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(IoTEventBatch)), "omnetpp::cPacket")
+{
+    propertyNames = nullptr;
+}
+
+IoTEventBatchDescriptor::~IoTEventBatchDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool IoTEventBatchDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<IoTEventBatch *>(obj)!=nullptr;
+}
+
+const char **IoTEventBatchDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *IoTEventBatchDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int IoTEventBatchDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 1+base->getFieldCount() : 1;
+}
+
+unsigned int IoTEventBatchDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISARRAY | FD_ISCOMPOUND | FD_ISRESIZABLE,    // FIELD_events
+    };
+    return (field >= 0 && field < 1) ? fieldTypeFlags[field] : 0;
+}
+
+const char *IoTEventBatchDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "events",
+    };
+    return (field >= 0 && field < 1) ? fieldNames[field] : nullptr;
+}
+
+int IoTEventBatchDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "events") == 0) return baseIndex + 0;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *IoTEventBatchDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "IoTEventRecord",    // FIELD_events
+    };
+    return (field >= 0 && field < 1) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **IoTEventBatchDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *IoTEventBatchDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int IoTEventBatchDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: return pp->getEventsArraySize();
+        default: return 0;
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: pp->setEventsArraySize(size); break;
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+const char *IoTEventBatchDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string IoTEventBatchDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: return "";
+        default: return "";
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+omnetpp::cValue IoTEventBatchDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: return omnetpp::toAnyPtr(&pp->getEvents(i)); break;
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'IoTEventBatch' as cValue -- field index out of range?", field);
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+const char *IoTEventBatchDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        case FIELD_events: return omnetpp::opp_typename(typeid(IoTEventRecord));
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr IoTEventBatchDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: return omnetpp::toAnyPtr(&pp->getEvents(i)); break;
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void IoTEventBatchDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    IoTEventBatch *pp = omnetpp::fromAnyPtr<IoTEventBatch>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'IoTEventBatch'", field);
+    }
+}
+
+namespace omnetpp {
+
+}  // namespace omnetpp
+
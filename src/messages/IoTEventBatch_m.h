@@ -0,0 +1,96 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.0 from messages/IoTEventBatch.msg.
+//
+#ifndef __IOTEVENTBATCH_M_H
+#define __IOTEVENTBATCH_M_H
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wreserved-id-macro"
+#endif
+#include <omnetpp.h>
+
+// opp_msgtool version check
+#define MSGC_VERSION 0x0600
+#if (MSGC_VERSION!=OMNETPP_VERSION)
+#    error Version mismatch! Probably this file was generated by an earlier version of opp_msgtool: 'make clean' should help.
+#endif
+
+struct IoTEventRecord;
+class IoTEventBatch;
+/**
+ * Struct generated from messages/IoTEventBatch.msg:19 by opp_msgtool.
+ */
+struct IoTEventRecord
+{
+    IoTEventRecord();
+    long eventID = 0;
+    bool toTrigger = false;
+    omnetpp::simtime_t timestamp = SIMTIME_ZERO;
+};
+
+// helpers for local use
+void __doPacking(omnetpp::cCommBuffer *b, const IoTEventRecord& a);
+void __doUnpacking(omnetpp::cCommBuffer *b, IoTEventRecord& a);
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const IoTEventRecord& obj) { __doPacking(b, obj); }
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, IoTEventRecord& obj) { __doUnpacking(b, obj); }
+
+/**
+ * Class generated from <tt>messages/IoTEventBatch.msg:29</tt> by opp_msgtool.
+ * <pre>
+ * //
+ * // IoT events generated in one tick of an event source, sent as a single
+ * // message
+ * //
+ * packet IoTEventBatch
+ * {
+ *     IoTEventRecord events[];
+ * }
+ * </pre>
+ */
+class IoTEventBatch : public ::omnetpp::cPacket
+{
+  protected:
+    IoTEventRecord *events = nullptr;
+    size_t events_arraysize = 0;
+
+  private:
+    void copy(const IoTEventBatch& other);
+
+  protected:
+    bool operator==(const IoTEventBatch&) = delete;
+
+  public:
+    IoTEventBatch(const char *name=nullptr, short kind=0);
+    IoTEventBatch(const IoTEventBatch& other);
+    virtual ~IoTEventBatch();
+    IoTEventBatch& operator=(const IoTEventBatch& other);
+    virtual IoTEventBatch *dup() const override {return new IoTEventBatch(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual void setEventsArraySize(size_t size);
+    virtual size_t getEventsArraySize() const;
+    virtual const IoTEventRecord& getEvents(size_t k) const;
+    virtual IoTEventRecord& getEventsForUpdate(size_t k) { return const_cast<IoTEventRecord&>(const_cast<IoTEventBatch*>(this)->getEvents(k));}
+    virtual void setEvents(size_t k, const IoTEventRecord& events);
+    virtual void insertEvents(size_t k, const IoTEventRecord& events);
+    [[deprecated]] void insertEvents(const IoTEventRecord& events) {appendEvents(events);}
+    virtual void appendEvents(const IoTEventRecord& events);
+    virtual void eraseEvents(size_t k);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const IoTEventBatch& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, IoTEventBatch& obj) {obj.parsimUnpack(b);}
+
+
+namespace omnetpp {
+
+inline any_ptr toAnyPtr(const IoTEventRecord *p) {return any_ptr(p);}
+template<> inline IoTEventRecord *fromAnyPtr(any_ptr ptr) { return ptr.get<IoTEventRecord>(); }
+template<> inline IoTEventBatch *fromAnyPtr(any_ptr ptr) { return check_and_cast<IoTEventBatch*>(ptr.get<cObject>()); }
+
+}  // namespace omnetpp
+
+#endif // ifndef __IOTEVENTBATCH_M_H
+
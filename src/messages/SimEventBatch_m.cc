@@ -0,0 +1,949 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.0 from messages/SimEventBatch.msg.
+//
+
+// Disable warnings about unused variables, empty switch stmts, etc:
+#ifdef _MSC_VER
+#  pragma warning(disable:4101)
+#  pragma warning(disable:4065)
+#endif
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wshadow"
+#  pragma clang diagnostic ignored "-Wconversion"
+#  pragma clang diagnostic ignored "-Wunused-parameter"
+#  pragma clang diagnostic ignored "-Wc++98-compat"
+#  pragma clang diagnostic ignored "-Wunreachable-code-break"
+#  pragma clang diagnostic ignored "-Wold-style-cast"
+#elif defined(__GNUC__)
+#  pragma GCC diagnostic ignored "-Wshadow"
+#  pragma GCC diagnostic ignored "-Wconversion"
+#  pragma GCC diagnostic ignored "-Wunused-parameter"
+#  pragma GCC diagnostic ignored "-Wold-style-cast"
+#  pragma GCC diagnostic ignored "-Wsuggest-attribute=noreturn"
+#  pragma GCC diagnostic ignored "-Wfloat-conversion"
+#endif
+
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <type_traits>
+#include "SimEventBatch_m.h"
+
+namespace omnetpp {
+
+// Template pack/unpack rules. They are declared *after* a1l type-specific pack functions for multiple reasons.
+// They are in the omnetpp namespace, to allow them to be found by argument-dependent lookup via the cCommBuffer argument
+
+// Packing/unpacking an std::vector
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::vector<T,A>& v)
+{
+    int n = v.size();
+    doParsimPacking(buffer, n);
+    for (int i = 0; i < n; i++)
+        doParsimPacking(buffer, v[i]);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::vector<T,A>& v)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    v.resize(n);
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(buffer, v[i]);
+}
+
+// Packing/unpacking an std::list
+template<typename T, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::list<T,A>& l)
+{
+    doParsimPacking(buffer, (int)l.size());
+    for (typename std::list<T,A>::const_iterator it = l.begin(); it != l.end(); ++it)
+        doParsimPacking(buffer, (T&)*it);
+}
+
+template<typename T, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::list<T,A>& l)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        l.push_back(T());
+        doParsimUnpacking(buffer, l.back());
+    }
+}
+
+// Packing/unpacking an std::set
+template<typename T, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::set<T,Tr,A>& s)
+{
+    doParsimPacking(buffer, (int)s.size());
+    for (typename std::set<T,Tr,A>::const_iterator it = s.begin(); it != s.end(); ++it)
+        doParsimPacking(buffer, *it);
+}
+
+template<typename T, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::set<T,Tr,A>& s)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        T x;
+        doParsimUnpacking(buffer, x);
+        s.insert(x);
+    }
+}
+
+// Packing/unpacking an std::map
+template<typename K, typename V, typename Tr, typename A>
+void doParsimPacking(omnetpp::cCommBuffer *buffer, const std::map<K,V,Tr,A>& m)
+{
+    doParsimPacking(buffer, (int)m.size());
+    for (typename std::map<K,V,Tr,A>::const_iterator it = m.begin(); it != m.end(); ++it) {
+        doParsimPacking(buffer, it->first);
+        doParsimPacking(buffer, it->second);
+    }
+}
+
+template<typename K, typename V, typename Tr, typename A>
+void doParsimUnpacking(omnetpp::cCommBuffer *buffer, std::map<K,V,Tr,A>& m)
+{
+    int n;
+    doParsimUnpacking(buffer, n);
+    for (int i = 0; i < n; i++) {
+        K k; V v;
+        doParsimUnpacking(buffer, k);
+        doParsimUnpacking(buffer, v);
+        m[k] = v;
+    }
+}
+
+// Default pack/unpack function for arrays
+template<typename T>
+void doParsimArrayPacking(omnetpp::cCommBuffer *b, const T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimPacking(b, t[i]);
+}
+
+template<typename T>
+void doParsimArrayUnpacking(omnetpp::cCommBuffer *b, T *t, int n)
+{
+    for (int i = 0; i < n; i++)
+        doParsimUnpacking(b, t[i]);
+}
+
+// Default rule to prevent compiler from choosing base class' doParsimPacking() function
+template<typename T>
+void doParsimPacking(omnetpp::cCommBuffer *, const T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimPacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+template<typename T>
+void doParsimUnpacking(omnetpp::cCommBuffer *, T& t)
+{
+    throw omnetpp::cRuntimeError("Parsim error: No doParsimUnpacking() function for type %s", omnetpp::opp_typename(typeid(t)));
+}
+
+}  // namespace omnetpp
+
+SimEventRecord::SimEventRecord()
+{
+}
+
+void __doPacking(omnetpp::cCommBuffer *b, const SimEventRecord& a)
+{
+    doParsimPacking(b,a.eventID);
+    doParsimPacking(b,a.timestamp);
+    doParsimPacking(b,a.count);
+    doParsimPacking(b,a.svId);
+}
+
+void __doUnpacking(omnetpp::cCommBuffer *b, SimEventRecord& a)
+{
+    doParsimUnpacking(b,a.eventID);
+    doParsimUnpacking(b,a.timestamp);
+    doParsimUnpacking(b,a.count);
+    doParsimUnpacking(b,a.svId);
+}
+
+class SimEventRecordDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_eventID,
+        FIELD_timestamp,
+        FIELD_count,
+        FIELD_svId,
+    };
+  public:
+    SimEventRecordDescriptor();
+    virtual ~SimEventRecordDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(SimEventRecordDescriptor)
+
+SimEventRecordDescriptor::SimEventRecordDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(SimEventRecord)), "")
+{
+    propertyNames = nullptr;
+}
+
+SimEventRecordDescriptor::~SimEventRecordDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool SimEventRecordDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<SimEventRecord *>(obj)!=nullptr;
+}
+
+const char **SimEventRecordDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *SimEventRecordDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int SimEventRecordDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 4+base->getFieldCount() : 4;
+}
+
+unsigned int SimEventRecordDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_eventID
+        FD_ISEDITABLE,    // FIELD_timestamp
+        FD_ISEDITABLE,    // FIELD_count
+        FD_ISEDITABLE,    // FIELD_svId
+    };
+    return (field >= 0 && field < 4) ? fieldTypeFlags[field] : 0;
+}
+
+const char *SimEventRecordDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "eventID",
+        "timestamp",
+        "count",
+        "svId",
+    };
+    return (field >= 0 && field < 4) ? fieldNames[field] : nullptr;
+}
+
+int SimEventRecordDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "eventID") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "timestamp") == 0) return baseIndex + 1;
+    if (strcmp(fieldName, "count") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "svId") == 0) return baseIndex + 3;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *SimEventRecordDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "long",    // FIELD_eventID
+        "omnetpp::simtime_t",    // FIELD_timestamp
+        "int",    // FIELD_count
+        "int",    // FIELD_svId
+    };
+    return (field >= 0 && field < 4) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **SimEventRecordDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *SimEventRecordDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int SimEventRecordDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        default: return 0;
+    }
+}
+
+void SimEventRecordDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'SimEventRecord'", field);
+    }
+}
+
+const char *SimEventRecordDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string SimEventRecordDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: return long2string(pp->eventID);
+        case FIELD_timestamp: return simtime2string(pp->timestamp);
+        case FIELD_count: return long2string(pp->count);
+        case FIELD_svId: return long2string(pp->svId);
+        default: return "";
+    }
+}
+
+void SimEventRecordDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: pp->eventID = string2long(value); break;
+        case FIELD_timestamp: pp->timestamp = string2simtime(value); break;
+        case FIELD_count: pp->count = string2long(value); break;
+        case FIELD_svId: pp->svId = string2long(value); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEventRecord'", field);
+    }
+}
+
+omnetpp::cValue SimEventRecordDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: return (omnetpp::intval_t)(pp->eventID);
+        case FIELD_timestamp: return pp->timestamp.dbl();
+        case FIELD_count: return pp->count;
+        case FIELD_svId: return pp->svId;
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'SimEventRecord' as cValue -- field index out of range?", field);
+    }
+}
+
+void SimEventRecordDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        case FIELD_eventID: pp->eventID = omnetpp::checked_int_cast<long>(value.intValue()); break;
+        case FIELD_timestamp: pp->timestamp = value.doubleValue(); break;
+        case FIELD_count: pp->count = omnetpp::checked_int_cast<int>(value.intValue()); break;
+        case FIELD_svId: pp->svId = omnetpp::checked_int_cast<int>(value.intValue()); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEventRecord'", field);
+    }
+}
+
+const char *SimEventRecordDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr SimEventRecordDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void SimEventRecordDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventRecord *pp = omnetpp::fromAnyPtr<SimEventRecord>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEventRecord'", field);
+    }
+}
+
+Register_Class(SimEventBatch)
+
+SimEventBatch::SimEventBatch(const char *name, short kind) : ::omnetpp::cPacket(name, kind)
+{
+}
+
+SimEventBatch::SimEventBatch(const SimEventBatch& other) : ::omnetpp::cPacket(other)
+{
+    copy(other);
+}
+
+SimEventBatch::~SimEventBatch()
+{
+    delete [] this->events;
+}
+
+SimEventBatch& SimEventBatch::operator=(const SimEventBatch& other)
+{
+    if (this == &other) return *this;
+    ::omnetpp::cPacket::operator=(other);
+    copy(other);
+    return *this;
+}
+
+void SimEventBatch::copy(const SimEventBatch& other)
+{
+    this->sequence = other.sequence;
+    delete [] this->events;
+    this->events = (other.events_arraysize==0) ? nullptr : new SimEventRecord[other.events_arraysize];
+    events_arraysize = other.events_arraysize;
+    for (size_t i = 0; i < events_arraysize; i++) {
+        this->events[i] = other.events[i];
+    }
+}
+
+void SimEventBatch::parsimPack(omnetpp::cCommBuffer *b) const
+{
+    ::omnetpp::cPacket::parsimPack(b);
+    doParsimPacking(b,this->sequence);
+    b->pack(events_arraysize);
+    doParsimArrayPacking(b,this->events,events_arraysize);
+}
+
+void SimEventBatch::parsimUnpack(omnetpp::cCommBuffer *b)
+{
+    ::omnetpp::cPacket::parsimUnpack(b);
+    doParsimUnpacking(b,this->sequence);
+    delete [] this->events;
+    b->unpack(events_arraysize);
+    if (events_arraysize == 0) {
+        this->events = nullptr;
+    } else {
+        this->events = new SimEventRecord[events_arraysize];
+        doParsimArrayUnpacking(b,this->events,events_arraysize);
+    }
+}
+
+long SimEventBatch::getSequence() const
+{
+    return this->sequence;
+}
+
+void SimEventBatch::setSequence(long sequence)
+{
+    this->sequence = sequence;
+}
+
+size_t SimEventBatch::getEventsArraySize() const
+{
+    return events_arraysize;
+}
+
+const SimEventRecord& SimEventBatch::getEvents(size_t k) const
+{
+    if (k >= events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    return this->events[k];
+}
+
+void SimEventBatch::setEventsArraySize(size_t newSize)
+{
+    SimEventRecord *events2 = (newSize==0) ? nullptr : new SimEventRecord[newSize];
+    size_t minSize = events_arraysize < newSize ? events_arraysize : newSize;
+    for (size_t i = 0; i < minSize; i++)
+        events2[i] = this->events[i];
+    delete [] this->events;
+    this->events = events2;
+    events_arraysize = newSize;
+}
+
+void SimEventBatch::setEvents(size_t k, const SimEventRecord& events)
+{
+    if (k >= events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    this->events[k] = events;
+}
+
+void SimEventBatch::insertEvents(size_t k, const SimEventRecord& events)
+{
+    if (k > events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    size_t newSize = events_arraysize + 1;
+    SimEventRecord *events2 = new SimEventRecord[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        events2[i] = this->events[i];
+    events2[k] = events;
+    for (i = k + 1; i < newSize; i++)
+        events2[i] = this->events[i-1];
+    delete [] this->events;
+    this->events = events2;
+    events_arraysize = newSize;
+}
+
+void SimEventBatch::appendEvents(const SimEventRecord& events)
+{
+    insertEvents(events_arraysize, events);
+}
+
+void SimEventBatch::eraseEvents(size_t k)
+{
+    if (k >= events_arraysize) throw omnetpp::cRuntimeError("Array of size %lu indexed by %lu", (unsigned long)events_arraysize, (unsigned long)k);
+    size_t newSize = events_arraysize - 1;
+    SimEventRecord *events2 = (newSize == 0) ? nullptr : new SimEventRecord[newSize];
+    size_t i;
+    for (i = 0; i < k; i++)
+        events2[i] = this->events[i];
+    for (i = k; i < newSize; i++)
+        events2[i] = this->events[i+1];
+    delete [] this->events;
+    this->events = events2;
+    events_arraysize = newSize;
+}
+
+class SimEventBatchDescriptor : public omnetpp::cClassDescriptor
+{
+  private:
+    mutable const char **propertyNames;
+    enum FieldConstants {
+        FIELD_sequence,
+        FIELD_events,
+    };
+  public:
+    SimEventBatchDescriptor();
+    virtual ~SimEventBatchDescriptor();
+
+    virtual bool doesSupport(omnetpp::cObject *obj) const override;
+    virtual const char **getPropertyNames() const override;
+    virtual const char *getProperty(const char *propertyName) const override;
+    virtual int getFieldCount() const override;
+    virtual const char *getFieldName(int field) const override;
+    virtual int findField(const char *fieldName) const override;
+    virtual unsigned int getFieldTypeFlags(int field) const override;
+    virtual const char *getFieldTypeString(int field) const override;
+    virtual const char **getFieldPropertyNames(int field) const override;
+    virtual const char *getFieldProperty(int field, const char *propertyName) const override;
+    virtual int getFieldArraySize(omnetpp::any_ptr object, int field) const override;
+    virtual void setFieldArraySize(omnetpp::any_ptr object, int field, int size) const override;
+
+    virtual const char *getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual std::string getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const override;
+    virtual omnetpp::cValue getFieldValue(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const override;
+
+    virtual const char *getFieldStructName(int field) const override;
+    virtual omnetpp::any_ptr getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const override;
+    virtual void setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const override;
+};
+
+Register_ClassDescriptor(SimEventBatchDescriptor)
+
+SimEventBatchDescriptor::SimEventBatchDescriptor() : omnetpp::cClassDescriptor(omnetpp::opp_typename(typeid(SimEventBatch)), "omnetpp::cPacket")
+{
+    propertyNames = nullptr;
+}
+
+SimEventBatchDescriptor::~SimEventBatchDescriptor()
+{
+    delete[] propertyNames;
+}
+
+bool SimEventBatchDescriptor::doesSupport(omnetpp::cObject *obj) const
+{
+    return dynamic_cast<SimEventBatch *>(obj)!=nullptr;
+}
+
+const char **SimEventBatchDescriptor::getPropertyNames() const
+{
+    if (!propertyNames) {
+        static const char *names[] = {  nullptr };
+        omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+        const char **baseNames = base ? base->getPropertyNames() : nullptr;
+        propertyNames = mergeLists(baseNames, names);
+    }
+    return propertyNames;
+}
+
+const char *SimEventBatchDescriptor::getProperty(const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? base->getProperty(propertyName) : nullptr;
+}
+
+int SimEventBatchDescriptor::getFieldCount() const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    return base ? 2+base->getFieldCount() : 2;
+}
+
+unsigned int SimEventBatchDescriptor::getFieldTypeFlags(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeFlags(field);
+        field -= base->getFieldCount();
+    }
+    static unsigned int fieldTypeFlags[] = {
+        FD_ISEDITABLE,    // FIELD_sequence
+        FD_ISARRAY | FD_ISCOMPOUND | FD_ISRESIZABLE,    // FIELD_events
+    };
+    return (field >= 0 && field < 2) ? fieldTypeFlags[field] : 0;
+}
+
+const char *SimEventBatchDescriptor::getFieldName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldName(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldNames[] = {
+        "sequence",
+        "events",
+    };
+    return (field >= 0 && field < 2) ? fieldNames[field] : nullptr;
+}
+
+int SimEventBatchDescriptor::findField(const char *fieldName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    int baseIndex = base ? base->getFieldCount() : 0;
+    if (strcmp(fieldName, "sequence") == 0) return baseIndex + 0;
+    if (strcmp(fieldName, "events") == 0) return baseIndex + 1;
+    return base ? base->findField(fieldName) : -1;
+}
+
+const char *SimEventBatchDescriptor::getFieldTypeString(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldTypeString(field);
+        field -= base->getFieldCount();
+    }
+    static const char *fieldTypeStrings[] = {
+        "long",    // FIELD_sequence
+        "SimEventRecord",    // FIELD_events
+    };
+    return (field >= 0 && field < 2) ? fieldTypeStrings[field] : nullptr;
+}
+
+const char **SimEventBatchDescriptor::getFieldPropertyNames(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldPropertyNames(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+const char *SimEventBatchDescriptor::getFieldProperty(int field, const char *propertyName) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldProperty(field, propertyName);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+int SimEventBatchDescriptor::getFieldArraySize(omnetpp::any_ptr object, int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldArraySize(object, field);
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: return pp->getEventsArraySize();
+        default: return 0;
+    }
+}
+
+void SimEventBatchDescriptor::setFieldArraySize(omnetpp::any_ptr object, int field, int size) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldArraySize(object, field, size);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: pp->setEventsArraySize(size); break;
+        default: throw omnetpp::cRuntimeError("Cannot set array size of field %d of class 'SimEventBatch'", field);
+    }
+}
+
+const char *SimEventBatchDescriptor::getFieldDynamicTypeString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldDynamicTypeString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        default: return nullptr;
+    }
+}
+
+std::string SimEventBatchDescriptor::getFieldValueAsString(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValueAsString(object,field,i);
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_sequence: return long2string(pp->getSequence());
+        case FIELD_events: return "";
+        default: return "";
+    }
+}
+
+void SimEventBatchDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int field, int i, const char *value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValueAsString(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_sequence: pp->setSequence(string2long(value)); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEventBatch'", field);
+    }
+}
+
+omnetpp::cValue SimEventBatchDescriptor::getFieldValue(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldValue(object,field,i);
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_sequence: return (omnetpp::intval_t)(pp->getSequence());
+        case FIELD_events: return omnetpp::toAnyPtr(&pp->getEvents(i)); break;
+        default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'SimEventBatch' as cValue -- field index out of range?", field);
+    }
+}
+
+void SimEventBatchDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i, const omnetpp::cValue& value) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldValue(object, field, i, value);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_sequence: pp->setSequence(omnetpp::checked_int_cast<long>(value.intValue())); break;
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEventBatch'", field);
+    }
+}
+
+const char *SimEventBatchDescriptor::getFieldStructName(int field) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructName(field);
+        field -= base->getFieldCount();
+    }
+    switch (field) {
+        case FIELD_events: return omnetpp::opp_typename(typeid(SimEventRecord));
+        default: return nullptr;
+    };
+}
+
+omnetpp::any_ptr SimEventBatchDescriptor::getFieldStructValuePointer(omnetpp::any_ptr object, int field, int i) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount())
+            return base->getFieldStructValuePointer(object, field, i);
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        case FIELD_events: return omnetpp::toAnyPtr(&pp->getEvents(i)); break;
+        default: return omnetpp::any_ptr(nullptr);
+    }
+}
+
+void SimEventBatchDescriptor::setFieldStructValuePointer(omnetpp::any_ptr object, int field, int i, omnetpp::any_ptr ptr) const
+{
+    omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
+    if (base) {
+        if (field < base->getFieldCount()){
+            base->setFieldStructValuePointer(object, field, i, ptr);
+            return;
+        }
+        field -= base->getFieldCount();
+    }
+    SimEventBatch *pp = omnetpp::fromAnyPtr<SimEventBatch>(object); (void)pp;
+    switch (field) {
+        default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEventBatch'", field);
+    }
+}
+
+namespace omnetpp {
+
+}  // namespace omnetpp
+
@@ -0,0 +1,104 @@
+//
+// Generated file, do not edit! Created by opp_msgtool 6.0 from messages/SimEventBatch.msg.
+//
+#ifndef __SIMEVENTBATCH_M_H
+#define __SIMEVENTBATCH_M_H
+
+#if defined(__clang__)
+#  pragma clang diagnostic ignored "-Wreserved-id-macro"
+#endif
+#include <omnetpp.h>
+
+// opp_msgtool version check
+#define MSGC_VERSION 0x0600
+#if (MSGC_VERSION!=OMNETPP_VERSION)
+#    error Version mismatch! Probably this file was generated by an earlier version of opp_msgtool: 'make clean' should help.
+#endif
+
+struct SimEventRecord;
+class SimEventBatch;
+/**
+ * Struct generated from messages/SimEventBatch.msg:19 by opp_msgtool.
+ */
+struct SimEventRecord
+{
+    SimEventRecord();
+    long eventID = 0;
+    omnetpp::simtime_t timestamp = SIMTIME_ZERO;
+    int count = 0;
+    int svId = 0;
+};
+
+// helpers for local use
+void __doPacking(omnetpp::cCommBuffer *b, const SimEventRecord& a);
+void __doUnpacking(omnetpp::cCommBuffer *b, SimEventRecord& a);
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const SimEventRecord& obj) { __doPacking(b, obj); }
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, SimEventRecord& obj) { __doUnpacking(b, obj); }
+
+/**
+ * Class generated from <tt>messages/SimEventBatch.msg:31</tt> by opp_msgtool.
+ * <pre>
+ * //
+ * // The operations of one operation set of a slice that go to one simulator,
+ * // sent as a single message. Batches are delivered in sequence order, so the
+ * // order between sets is kept at every simulator.
+ * //
+ * packet SimEventBatch
+ * {
+ *     // number of the batch since the start of the simulation
+ *     long sequence;
+ *     SimEventRecord events[];
+ * }
+ * </pre>
+ */
+class SimEventBatch : public ::omnetpp::cPacket
+{
+  protected:
+    long sequence = 0;
+    SimEventRecord *events = nullptr;
+    size_t events_arraysize = 0;
+
+  private:
+    void copy(const SimEventBatch& other);
+
+  protected:
+    bool operator==(const SimEventBatch&) = delete;
+
+  public:
+    SimEventBatch(const char *name=nullptr, short kind=0);
+    SimEventBatch(const SimEventBatch& other);
+    virtual ~SimEventBatch();
+    SimEventBatch& operator=(const SimEventBatch& other);
+    virtual SimEventBatch *dup() const override {return new SimEventBatch(*this);}
+    virtual void parsimPack(omnetpp::cCommBuffer *b) const override;
+    virtual void parsimUnpack(omnetpp::cCommBuffer *b) override;
+
+    virtual long getSequence() const;
+    virtual void setSequence(long sequence);
+
+    virtual void setEventsArraySize(size_t size);
+    virtual size_t getEventsArraySize() const;
+    virtual const SimEventRecord& getEvents(size_t k) const;
+    virtual SimEventRecord& getEventsForUpdate(size_t k) { return const_cast<SimEventRecord&>(const_cast<SimEventBatch*>(this)->getEvents(k));}
+    virtual void setEvents(size_t k, const SimEventRecord& events);
+    virtual void insertEvents(size_t k, const SimEventRecord& events);
+    [[deprecated]] void insertEvents(const SimEventRecord& events) {appendEvents(events);}
+    virtual void appendEvents(const SimEventRecord& events);
+    virtual void eraseEvents(size_t k);
+};
+
+inline void doParsimPacking(omnetpp::cCommBuffer *b, const SimEventBatch& obj) {obj.parsimPack(b);}
+inline void doParsimUnpacking(omnetpp::cCommBuffer *b, SimEventBatch& obj) {obj.parsimUnpack(b);}
+
+
+namespace omnetpp {
+
+inline any_ptr toAnyPtr(const SimEventRecord *p) {return any_ptr(p);}
+template<> inline SimEventRecord *fromAnyPtr(any_ptr ptr) { return ptr.get<SimEventRecord>(); }
+template<> inline SimEventBatch *fromAnyPtr(any_ptr ptr) { return check_and_cast<SimEventBatch*>(ptr.get<cObject>()); }
+
+}  // namespace omnetpp
+
+#endif // ifndef __SIMEVENTBATCH_M_H
+
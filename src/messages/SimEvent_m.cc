@@ -178,6 +178,7 @@ void SimEvent::copy(const SimEvent& other)
     this->eventID = other.eventID;
     this->timestamp = other.timestamp;
     this->count = other.count;
+    this->svId = other.svId;
 }
 
 void SimEvent::parsimPack(omnetpp::cCommBuffer *b) const
@@ -186,6 +187,7 @@ void SimEvent::parsimPack(omnetpp::cCommBuffer *b) const
     doParsimPacking(b,this->eventID);
     doParsimPacking(b,this->timestamp);
     doParsimPacking(b,this->count);
+    doParsimPacking(b,this->svId);
 }
 
 void SimEvent::parsimUnpack(omnetpp::cCommBuffer *b)
@@ -194,6 +196,7 @@ void SimEvent::parsimUnpack(omnetpp::cCommBuffer *b)
     doParsimUnpacking(b,this->eventID);
     doParsimUnpacking(b,this->timestamp);
     doParsimUnpacking(b,this->count);
+    doParsimUnpacking(b,this->svId);
 }
 
 long SimEvent::getEventID() const
@@ -226,6 +229,16 @@ void SimEvent::setCount(int count)
     this->count = count;
 }
 
+int SimEvent::getSvId() const
+{
+    return this->svId;
+}
+
+void SimEvent::setSvId(int svId)
+{
+    this->svId = svId;
+}
+
 class SimEventDescriptor : public omnetpp::cClassDescriptor
 {
   private:
@@ -234,6 +247,7 @@ class SimEventDescriptor : public omnetpp::cClassDescriptor
         FIELD_eventID,
         FIELD_timestamp,
         FIELD_count,
+        FIELD_svId,
     };
   public:
     SimEventDescriptor();
@@ -300,7 +314,7 @@ const char *SimEventDescriptor::getProperty(const char *propertyName) const
 int SimEventDescriptor::getFieldCount() const
 {
     omnetpp::cClassDescriptor *base = getBaseClassDescriptor();
-    return base ? 3+base->getFieldCount() : 3;
+    return base ? 4+base->getFieldCount() : 4;
 }
 
 unsigned int SimEventDescriptor::getFieldTypeFlags(int field) const
@@ -315,8 +329,9 @@ unsigned int SimEventDescriptor::getFieldTypeFlags(int field) const
         FD_ISEDITABLE,    // FIELD_eventID
         FD_ISEDITABLE,    // FIELD_timestamp
         FD_ISEDITABLE,    // FIELD_count
+        FD_ISEDITABLE,    // FIELD_svId
     };
-    return (field >= 0 && field < 3) ? fieldTypeFlags[field] : 0;
+    return (field >= 0 && field < 4) ? fieldTypeFlags[field] : 0;
 }
 
 const char *SimEventDescriptor::getFieldName(int field) const
@@ -331,8 +346,9 @@ const char *SimEventDescriptor::getFieldName(int field) const
         "eventID",
         "timestamp",
         "count",
+        "svId",
     };
-    return (field >= 0 && field < 3) ? fieldNames[field] : nullptr;
+    return (field >= 0 && field < 4) ? fieldNames[field] : nullptr;
 }
 
 int SimEventDescriptor::findField(const char *fieldName) const
@@ -342,6 +358,7 @@ int SimEventDescriptor::findField(const char *fieldName) const
     if (strcmp(fieldName, "eventID") == 0) return baseIndex + 0;
     if (strcmp(fieldName, "timestamp") == 0) return baseIndex + 1;
     if (strcmp(fieldName, "count") == 0) return baseIndex + 2;
+    if (strcmp(fieldName, "svId") == 0) return baseIndex + 3;
     return base ? base->findField(fieldName) : -1;
 }
 
@@ -357,8 +374,9 @@ const char *SimEventDescriptor::getFieldTypeString(int field) const
         "long",    // FIELD_eventID
         "omnetpp::simtime_t",    // FIELD_timestamp
         "int",    // FIELD_count
+        "int",    // FIELD_svId
     };
-    return (field >= 0 && field < 3) ? fieldTypeStrings[field] : nullptr;
+    return (field >= 0 && field < 4) ? fieldTypeStrings[field] : nullptr;
 }
 
 const char **SimEventDescriptor::getFieldPropertyNames(int field) const
@@ -444,6 +462,7 @@ std::string SimEventDescriptor::getFieldValueAsString(omnetpp::any_ptr object, i
         case FIELD_eventID: return long2string(pp->getEventID());
         case FIELD_timestamp: return simtime2string(pp->getTimestamp());
         case FIELD_count: return long2string(pp->getCount());
+        case FIELD_svId: return long2string(pp->getSvId());
         default: return "";
     }
 }
@@ -463,6 +482,7 @@ void SimEventDescriptor::setFieldValueAsString(omnetpp::any_ptr object, int fiel
         case FIELD_eventID: pp->setEventID(string2long(value)); break;
         case FIELD_timestamp: pp->setTimestamp(string2simtime(value)); break;
         case FIELD_count: pp->setCount(string2long(value)); break;
+        case FIELD_svId: pp->setSvId(string2long(value)); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEvent'", field);
     }
 }
@@ -480,6 +500,7 @@ omnetpp::cValue SimEventDescriptor::getFieldValue(omnetpp::any_ptr object, int f
         case FIELD_eventID: return (omnetpp::intval_t)(pp->getEventID());
         case FIELD_timestamp: return pp->getTimestamp().dbl();
         case FIELD_count: return pp->getCount();
+        case FIELD_svId: return pp->getSvId();
         default: throw omnetpp::cRuntimeError("Cannot return field %d of class 'SimEvent' as cValue -- field index out of range?", field);
     }
 }
@@ -499,6 +520,7 @@ void SimEventDescriptor::setFieldValue(omnetpp::any_ptr object, int field, int i
         case FIELD_eventID: pp->setEventID(omnetpp::checked_int_cast<long>(value.intValue())); break;
         case FIELD_timestamp: pp->setTimestamp(value.doubleValue()); break;
         case FIELD_count: pp->setCount(omnetpp::checked_int_cast<int>(value.intValue())); break;
+        case FIELD_svId: pp->setSvId(omnetpp::checked_int_cast<int>(value.intValue())); break;
         default: throw omnetpp::cRuntimeError("Cannot set field %d of class 'SimEvent'", field);
     }
 }
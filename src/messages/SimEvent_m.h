@@ -28,6 +28,7 @@ class SimEvent;
  *     long eventID;
  *     simtime_t timestamp;
  *     int count;
+ *     int svId;
  * }
  * </pre>
  */
@@ -37,6 +38,7 @@ class SimEvent : public ::omnetpp::cPacket
     long eventID = 0;
     omnetpp::simtime_t timestamp = SIMTIME_ZERO;
     int count = 0;
+    int svId = 0;
 
   private:
     void copy(const SimEvent& other);
@@ -61,6 +63,9 @@ class SimEvent : public ::omnetpp::cPacket
 
     virtual int getCount() const;
     virtual void setCount(int count);
+
+    virtual int getSvId() const;
+    virtual void setSvId(int svId);
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const SimEvent& obj) {obj.parsimPack(b);}
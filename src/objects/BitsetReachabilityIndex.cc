@@ -0,0 +1,135 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include "BitsetReachabilityIndex.h"
+
+BitsetReachabilityIndex::BitsetReachabilityIndex() :
+        ReachabilityIndex() {
+    words = 0;
+    numRows = 0;
+    rows = nullptr;
+}
+
+void BitsetReachabilityIndex::build(int n, const vector<pair<int, int>>& edges) {
+    this->n = n;
+    words = (n + 63) / 64;
+
+    vector<int> offsets;
+    vector<int> targets;
+    toCSR(n, edges, offsets, targets);
+
+    int size = condense(offsets, targets);
+
+    // group vertices by component
+    vector<int> memberOffsets(size + 1, 0);
+    for (int v = 0; v < n; v++) {
+        memberOffsets[component[v] + 1]++;
+    }
+    for (int c = 0; c < size; c++) {
+        memberOffsets[c + 1] += memberOffsets[c];
+    }
+    vector<int> members(n);
+    vector<int> cursor(memberOffsets.begin(), memberOffsets.end() - 1);
+    for (int v = 0; v < n; v++) {
+        members[cursor[component[v]]++] = v;
+    }
+
+    /*
+     * build closure rows, successors first
+     */
+    image.reset();
+    ownRows.assign((size_t) size * words, 0);
+    rows = ownRows.data();
+    numRows = size;
+    // last component that merged a given component's row
+    vector<int> merged(size, -1);
+    for (int c = 0; c < size; c++) {
+        uint64_t* row = &ownRows[(size_t) c * words];
+        bool cyclic = memberOffsets[c + 1] - memberOffsets[c] > 1;
+
+        for (int m = memberOffsets[c]; m < memberOffsets[c + 1]; m++) {
+            int v = members[m];
+            for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+                int w = targets[e];
+                int d = component[w];
+                if (d == c) {
+                    // self-loop or edge inside a cycle
+                    cyclic = true;
+                    continue;
+                }
+                row[w >> 6] |= uint64_t(1) << (w & 63);
+                if (merged[d] != c) {
+                    merged[d] = c;
+                    const uint64_t* succ = &rows[(size_t) d * words];
+                    for (int k = 0; k < words; k++) {
+                        row[k] |= succ[k];
+                    }
+                }
+            }
+        }
+
+        if (cyclic) {
+            for (int m = memberOffsets[c]; m < memberOffsets[c + 1]; m++) {
+                int v = members[m];
+                row[v >> 6] |= uint64_t(1) << (v & 63);
+            }
+        }
+    }
+}
+
+size_t BitsetReachabilityIndex::memoryUsage() const {
+    return (size_t) numRows * words * sizeof(uint64_t)
+            + component.size() * sizeof(int);
+}
+
+void BitsetReachabilityIndex::save(BinaryWriter& out) const {
+    saveComponents(out);
+    out.put<int32_t>(numRows);
+    out.putArray(rows, (size_t) numRows * words);
+}
+
+bool BitsetReachabilityIndex::load(BinaryReader& in,
+        shared_ptr<const MappedFile> image) {
+    int32_t size = 0;
+    const uint64_t* data = nullptr;
+    size_t count = 0;
+    if (!loadComponents(in) || !in.get(size) || !in.view(data, count)) {
+        return false;
+    }
+    words = (n + 63) / 64;
+    if (count != (size_t) size * words) {
+        return false;
+    }
+    for (int c : component) {
+        if (c < 0 || c >= size) {
+            return false;
+        }
+    }
+    numRows = size;
+    ownRows.clear();
+    if (image) {
+        // use the rows in place, the mapping outlives this index
+        this->image = image;
+        rows = data;
+    } else {
+        ownRows.assign(data, data + count);
+        rows = ownRows.data();
+    }
+    return true;
+}
+
+BitsetReachabilityIndex::~BitsetReachabilityIndex() {
+
+}
@@ -0,0 +1,59 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_BITSETREACHABILITYINDEX_H_
+#define OBJECTS_BITSETREACHABILITYINDEX_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "ReachabilityIndex.h"
+
+using namespace std;
+
+/*
+ * Transitive closure stored as word-packed bitset rows.
+ *
+ * Component closures are built in reverse topological order, so that each
+ * inter-component edge costs one row OR of n/64 words. Vertices of the
+ * same component share one row.
+ */
+class BitsetReachabilityIndex: public ReachabilityIndex {
+private:
+    // number of 64-bit words per row
+    int words;
+    int numRows;
+    // row-major closure, one row of n bits per component
+    const uint64_t* rows;
+    // rows built in memory, or the image the rows are mapped from
+    vector<uint64_t> ownRows;
+    shared_ptr<const MappedFile> image;
+public:
+    BitsetReachabilityIndex();
+    void build(int n, const vector<pair<int, int>>& edges) override;
+    bool isReachable(int src, int dest) const override {
+        const uint64_t* row = &rows[(size_t) component[src] * words];
+        return (row[dest >> 6] >> (dest & 63)) & 1;
+    }
+    size_t memoryUsage() const override;
+    Strategy getStrategy() const override {
+        return BITSET;
+    }
+    void save(BinaryWriter& out) const override;
+    bool load(BinaryReader& in, shared_ptr<const MappedFile> image) override;
+    virtual ~BitsetReachabilityIndex();
+};
+
+#endif /* OBJECTS_BITSETREACHABILITYINDEX_H_ */
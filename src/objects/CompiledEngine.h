@@ -0,0 +1,132 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_COMPILEDENGINE_H_
+#define OBJECTS_COMPILEDENGINE_H_
+
+#include <utility>
+#include "ReasoningEngine.h"
+#include "SituationRelation.h"
+
+using namespace std;
+
+/*
+ * ReasoningEngine over a model fixed at build time, for the lowest
+ * reasoning latency on small embedded deployments. Model is generated by
+ * sgcompile -e and holds the upper situations as constexpr arrays:
+ *
+ *   NODES, HEIGHT, UPPER   situations, layers and upper situations
+ *   ids[NODES]             situation ID by dense index
+ *   layerSlots[HEIGHT]     first slot of each upper layer, and the end
+ *   slotNodes[UPPER]       dense index of each slot, layers in layer order
+ *   edgeOffsets[UPPER + 1] evidence range of each slot
+ *   orStarts[UPPER]        where the OR evidences of a slot start
+ *   sources[]              evidences of all slots one after another
+ *
+ * Arrays that would be empty hold one unused element. The layer loop is
+ * unrolled at compile time, each layer a loop over constant bounds.
+ */
+template <typename Model>
+class CompiledEngine: public ReasoningEngine {
+private:
+    static bool satisfied(int slot, const int* counters, int counter) {
+        int k = Model::edgeOffsets[slot];
+        for (; k < Model::orStarts[slot]; k++) {
+            if (counters[Model::sources[k]] <= counter) {
+                return false;
+            }
+        }
+        if (k == Model::edgeOffsets[slot + 1]) {
+            return true;
+        }
+        for (; k < Model::edgeOffsets[slot + 1]; k++) {
+            if (counters[Model::sources[k]] > counter) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <int L>
+    void sweepLayer(int* counters, simtime_t current) {
+        for (int slot = Model::layerSlots[L]; slot < Model::layerSlots[L + 1];
+                slot++) {
+            int index = Model::slotNodes[slot];
+            if (satisfied(slot, counters, counters[index])) {
+                trigger(index, current);
+            }
+        }
+    }
+
+    // upper layers from HEIGHT - 2 up to 0
+    template <int... K>
+    void sweepLayers(int* counters, simtime_t current,
+            integer_sequence<int, K...>) {
+        (sweepLayer<Model::HEIGHT - 2 - K>(counters, current), ...);
+    }
+public:
+    bool accepts(const SituationGraph& sg) const override {
+        if (sg.numNodes() != Model::NODES
+                || sg.modelHeight() != Model::HEIGHT) {
+            return false;
+        }
+        for (int i = 0; i < Model::NODES; i++) {
+            if (sg.idAt(i) != Model::ids[i]) {
+                return false;
+            }
+        }
+        int slot = 0;
+        for (int l = 0; l < Model::HEIGHT - 1; l++) {
+            for (auto index : sg.getLayerIndices(l)) {
+                if (slot == Model::UPPER || Model::slotNodes[slot] != index) {
+                    return false;
+                }
+                // AND and SOLE evidences first, then OR, each in model order
+                Span<int> evidences = sg.getEvidences(index);
+                Span<char> relations = sg.getEvidenceRelations(index);
+                int k = Model::edgeOffsets[slot];
+                if (Model::edgeOffsets[slot + 1] - k != (int) evidences.size()) {
+                    return false;
+                }
+                for (int pass = 0; pass < 2; pass++) {
+                    for (size_t e = 0; e < evidences.size(); e++) {
+                        bool isOr = relations[e] == SituationRelation::OR;
+                        if (isOr != (pass == 1)) {
+                            continue;
+                        }
+                        if (isOr && k < Model::orStarts[slot]) {
+                            return false;
+                        }
+                        if (Model::sources[k++] != evidences[e]) {
+                            return false;
+                        }
+                    }
+                    if (pass == 0 && k != Model::orStarts[slot]) {
+                        return false;
+                    }
+                }
+                slot++;
+            }
+        }
+        return slot == Model::UPPER;
+    }
+
+    void sweep(Span<int> /* bottoms */, simtime_t current) override {
+        sweepLayers(counters(), current,
+                make_integer_sequence<int, Model::HEIGHT - 1>());
+    }
+};
+
+#endif /* OBJECTS_COMPILEDENGINE_H_ */
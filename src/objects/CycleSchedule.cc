@@ -0,0 +1,91 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <numeric>
+#include "CycleSchedule.h"
+
+CycleSchedule::CycleSchedule() {
+    clear();
+}
+
+void CycleSchedule::clear() {
+    grid = 1;
+    hyperperiod = 1;
+    slotOffsets.clear();
+    slotIndices.clear();
+    peak = 0;
+}
+
+bool CycleSchedule::build(Span<int> indices, const vector<simtime_t>& cycles) {
+    clear();
+    int64_t g = 0;
+    for (auto i : indices) {
+        if (cycles[i] > 0) {
+            g = gcd(g, cycles[i].raw());
+        }
+    }
+    if (g == 0) {
+        return false;
+    }
+
+    // hyperperiod and entries in grid units, within the limits
+    int64_t slots = 1;
+    for (auto i : indices) {
+        if (cycles[i] > 0) {
+            int64_t c = cycles[i].raw() / g;
+            int64_t f = c / gcd(slots, c);
+            if (f > MAX_SLOTS / slots) {
+                return false;
+            }
+            slots *= f;
+        }
+    }
+    int64_t entries = 0;
+    for (auto i : indices) {
+        if (cycles[i] > 0) {
+            entries += slots / (cycles[i].raw() / g);
+            if (entries > MAX_ENTRIES) {
+                return false;
+            }
+        }
+    }
+
+    slotOffsets.assign(slots + 1, 0);
+    for (auto i : indices) {
+        if (cycles[i] > 0) {
+            int64_t c = cycles[i].raw() / g;
+            for (int64_t k = 0; k < slots; k += c) {
+                slotOffsets[k + 1]++;
+            }
+        }
+    }
+    for (int64_t k = 0; k < slots; k++) {
+        peak = max(peak, slotOffsets[k + 1]);
+        slotOffsets[k + 1] += slotOffsets[k];
+    }
+    slotIndices.resize(entries);
+    vector<int> cursor(slotOffsets.begin(), slotOffsets.end() - 1);
+    for (auto i : indices) {
+        if (cycles[i] > 0) {
+            int64_t c = cycles[i].raw() / g;
+            for (int64_t k = 0; k < slots; k += c) {
+                slotIndices[cursor[k]++] = i;
+            }
+        }
+    }
+    grid = g;
+    hyperperiod = slots * g;
+    return true;
+}
@@ -0,0 +1,83 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_CYCLESCHEDULE_H_
+#define OBJECTS_CYCLESCHEDULE_H_
+
+#include <omnetpp.h>
+#include <cstdint>
+#include <vector>
+#include "../common/Span.h"
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Due table of cyclic situations over their hyperperiod.
+ *
+ * A situation with a positive cycle is due at every multiple of it, so
+ * the due pattern of a set of situations repeats after the LCM of their
+ * cycles. Nothing is due off the grid of the GCD of the cycles, so the
+ * table has one slot per grid point of the hyperperiod, listing the
+ * situations due there in the order they were given (CSR). Cycles whose
+ * LCM would need more than MAX_SLOTS slots, or more than MAX_ENTRIES
+ * entries, are not tabulated.
+ */
+class CycleSchedule {
+private:
+    // grid and hyperperiod in raw simulation time
+    int64_t grid;
+    int64_t hyperperiod;
+    vector<int> slotOffsets;
+    vector<int> slotIndices;
+    int peak;
+public:
+    static const int64_t MAX_SLOTS = 1 << 20;
+    static const int64_t MAX_ENTRIES = 1 << 22;
+
+    CycleSchedule();
+    /*
+     * Tabulate the situations at the given indices, by their cycles.
+     * Return false, leaving the table empty, if none has a positive cycle
+     * or the table would be too large.
+     */
+    bool build(Span<int> indices, const vector<simtime_t>& cycles);
+    void clear();
+    bool isBuilt() const {
+        return !slotOffsets.empty();
+    }
+    // situations due at a time, which must not be negative
+    Span<int> dueAt(simtime_t time) const {
+        int64_t t = time.raw();
+        if (t % grid != 0) {
+            return Span<int>();
+        }
+        int64_t k = t % hyperperiod / grid;
+        return Span<int>(slotIndices.data() + slotOffsets[k],
+                slotIndices.data() + slotOffsets[k + 1]);
+    }
+    simtime_t getGrid() const {
+        return SimTime::fromRaw(grid);
+    }
+    simtime_t getHyperperiod() const {
+        return SimTime::fromRaw(hyperperiod);
+    }
+    // most situations due at one time, the peak events of a tick
+    int peakDue() const {
+        return peak;
+    }
+};
+
+#endif /* OBJECTS_CYCLESCHEDULE_H_ */
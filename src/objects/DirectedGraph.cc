@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <unordered_set>
 #include "DirectedGraph.h"
 
 DirectedGraph::DirectedGraph() {
@@ -66,13 +67,14 @@ vector<long> DirectedGraph::topo_sort() {
     }
 
     // add orphan vertices at the beginning of the vector to return
-    int i = 0;
+    unordered_set<long> sorted(ans.begin(), ans.end());
+    vector<long> orphans;
     for (auto vertex : verList) {
-        if (find(ans.begin(), ans.end(), vertex) == ans.end()) {
-            ans.insert(ans.begin() + i, vertex);
-            i++;
+        if (!sorted.count(vertex)) {
+            orphans.push_back(vertex);
         }
     }
+    ans.insert(ans.begin(), orphans.begin(), orphans.end());
 
     return ans;
 }
@@ -0,0 +1,165 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "EventLog.h"
+
+EventLog::EventLog() {
+    segmentSize = 0;
+    head = 0;
+    count = 0;
+    spillOffset = 0;
+    mappedOffset = 0;
+    dropped = 0;
+    latest = INT64_MIN;
+    configure(4096, 64, "");
+}
+
+bool EventLog::configure(size_t segmentSize, size_t numSegments,
+        const string& spillFile) {
+    close();
+    this->segmentSize = max<size_t>(segmentSize, 1);
+    // segments grow on first use and keep their capacity when overwritten
+    segments.assign(max<size_t>(numSegments, 1), Segment());
+    head = 0;
+    count = 0;
+    spilled.clear();
+    spillOffset = 0;
+    dropped = 0;
+    latest = INT64_MIN;
+
+    this->spillFile = spillFile;
+    if (!spillFile.empty()) {
+        spill.open(spillFile, ios::binary | ios::trunc);
+        if (!spill) {
+            this->spillFile.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void EventLog::evict() {
+    Segment& oldest = segmentAt(0);
+    if (spill.is_open()) {
+        SpilledSegment s;
+        s.offset = spillOffset;
+        s.count = oldest.events.size();
+        s.minTime = oldest.minTime;
+        s.maxTime = oldest.maxTime;
+        spill.write((const char*) oldest.events.data(),
+                oldest.events.size() * sizeof(OperationalEvent));
+        spillOffset += oldest.events.size() * sizeof(OperationalEvent);
+        spilled.push_back(s);
+    } else {
+        dropped += oldest.events.size();
+    }
+    oldest.events.clear();
+    head = (head + 1) % segments.size();
+    count--;
+}
+
+void EventLog::append(const OperationalEvent& event) {
+    if (count == 0 || segmentAt(count - 1).events.size() == segmentSize) {
+        if (count == segments.size()) {
+            evict();
+        }
+        Segment& segment = segmentAt(count++);
+        segment.minTime = INT64_MAX;
+        segment.maxTime = INT64_MIN;
+    }
+    Segment& segment = segmentAt(count - 1);
+    segment.events.push_back(event);
+    segment.minTime = min(segment.minTime, event.time);
+    segment.maxTime = max(segment.maxTime, event.time);
+    latest = max(latest, event.time);
+}
+
+bool EventLog::mapSpill() {
+    if (mapping && mappedOffset == spillOffset) {
+        return true;
+    }
+    spill.flush();
+    mapping.reset(new MappedFile());
+    if (!spill || !mapping->open(spillFile) || mapping->size() < spillOffset) {
+        mapping.reset();
+        return false;
+    }
+    mappedOffset = spillOffset;
+    return true;
+}
+
+bool EventLog::scan(simtime_t from, simtime_t to,
+        vector<OperationalEvent>& events) {
+    int64_t lo = from.raw();
+    int64_t hi = to.raw();
+    bool ok = true;
+
+    for (auto& s : spilled) {
+        if (s.maxTime < lo || s.minTime >= hi) {
+            continue;
+        }
+        if (!mapSpill()) {
+            ok = false;
+            break;
+        }
+        const char* data = (const char*) mapping->data() + s.offset;
+        for (uint64_t i = 0; i < s.count; i++) {
+            OperationalEvent event;
+            memcpy(&event, data + i * sizeof(OperationalEvent), sizeof(event));
+            if (event.time >= lo && event.time < hi) {
+                events.push_back(event);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        const Segment& segment = segmentAt(i);
+        if (segment.maxTime < lo || segment.minTime >= hi) {
+            continue;
+        }
+        for (auto& event : segment.events) {
+            if (event.time >= lo && event.time < hi) {
+                events.push_back(event);
+            }
+        }
+    }
+    return ok;
+}
+
+size_t EventLog::size() const {
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        n += segmentAt(i).events.size();
+    }
+    return n;
+}
+
+size_t EventLog::spilledEvents() const {
+    return spillOffset / sizeof(OperationalEvent);
+}
+
+void EventLog::close() {
+    mapping.reset();
+    mappedOffset = 0;
+    if (spill.is_open()) {
+        spill.close();
+    }
+}
+
+EventLog::~EventLog() {
+    close();
+}
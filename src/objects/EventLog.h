@@ -0,0 +1,113 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_EVENTLOG_H_
+#define OBJECTS_EVENTLOG_H_
+
+#include <omnetpp.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/MappedFile.h"
+#include "OperationalEvent.h"
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Append-only log of IoT events with range scans by timestamp. No module
+ * logs into it yet: re-reasoning the slices a late event falls into
+ * would also need the reasoner and the simulators rolled back.
+ *
+ * Events are kept in arrival order in a ring of fixed-size segments, each
+ * with the range of the timestamps in it, so that a range scan skips the
+ * segments outside the range and the memory stays bounded. The oldest
+ * segment is overwritten when the ring is full, or first appended to a
+ * spill file if there is one; spilled segments are scanned through a
+ * mapping of that file.
+ */
+class EventLog {
+private:
+    struct Segment {
+        vector<OperationalEvent> events;
+        int64_t minTime;
+        int64_t maxTime;
+    };
+    struct SpilledSegment {
+        uint64_t offset;
+        uint64_t count;
+        int64_t minTime;
+        int64_t maxTime;
+    };
+
+    size_t segmentSize;
+    // segments in memory, oldest at head
+    vector<Segment> segments;
+    size_t head;
+    size_t count;
+    ofstream spill;
+    string spillFile;
+    uint64_t spillOffset;
+    vector<SpilledSegment> spilled;
+    // mapping of the spill file, up to spillOffset when mapped
+    unique_ptr<MappedFile> mapping;
+    uint64_t mappedOffset;
+    // events overwritten without a spill file
+    long dropped;
+    int64_t latest;
+
+    Segment& segmentAt(size_t i) {
+        return segments[(head + i) % segments.size()];
+    }
+    const Segment& segmentAt(size_t i) const {
+        return segments[(head + i) % segments.size()];
+    }
+    void evict();
+    bool mapSpill();
+public:
+    EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+    /*
+     * Keep up to numSegments segments of segmentSize events in memory, and
+     * spill older ones to spillFile unless it is "". Clears the log, return
+     * false if the spill file cannot be opened.
+     */
+    bool configure(size_t segmentSize, size_t numSegments,
+            const string& spillFile);
+    void append(const OperationalEvent& event);
+    /*
+     * Append the logged events with from <= timestamp < to to events, in
+     * arrival order, spilled ones included. Return false if the spill file
+     * could not be read.
+     */
+    bool scan(simtime_t from, simtime_t to, vector<OperationalEvent>& events);
+    // events in memory, see spilledEvents and droppedEvents for the others
+    size_t size() const;
+    size_t spilledEvents() const;
+    long droppedEvents() const {
+        return dropped;
+    }
+    // latest timestamp appended so far, or a negative time if none
+    simtime_t latestTimestamp() const {
+        return SimTime::fromRaw(latest);
+    }
+    void close();
+    virtual ~EventLog();
+};
+
+#endif /* OBJECTS_EVENTLOG_H_ */
@@ -0,0 +1,120 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <algorithm>
+#include "IncrementalEngine.h"
+
+IncrementalEngine::IncrementalEngine(Mode mode) {
+    this->mode = mode;
+}
+
+void IncrementalEngine::attach(SituationReasoner& sr) {
+    ReasoningEngine::attach(sr);
+
+    int size = sg->numNodes();
+    worklists.assign(sg->modelHeight(), vector<int>());
+    queued.assign(size, 0);
+    deferred.assign(size, 0);
+    pending.clear();
+    for (int i = sg->modelHeight() - 2; i >= 0; i--) {
+        for (auto upper : sg->getLayerIndices(i)) {
+            defer(upper);
+        }
+    }
+}
+
+bool IncrementalEngine::canTrigger(int index) const {
+    int* counts = counters();
+    if (mode == WEIGHTED) {
+        Span<int> evidences = sg->getEvidences(index);
+        double sum = TriggerKernel::weightedSum(evidences.begin(),
+                sg->getEvidenceWeights(index).begin(), evidences.size(),
+                counts, counts[index]);
+        return TriggerKernel::reaches(sum, sg->getThreshold(index));
+    }
+    return TriggerKernel::satisfied(sg->getEvidences(index),
+            sg->getEvidenceRelations(index), counts, counts[index]);
+}
+
+void IncrementalEngine::enqueue(int index) {
+    if (!queued[index]) {
+        queued[index] = 1;
+        vector<int>& worklist = worklists[sg->getLayerOf(index)];
+        worklist.push_back(index);
+        push_heap(worklist.begin(), worklist.end(), [this](int a, int b) {
+            return sg->getLayerPosition(a) > sg->getLayerPosition(b);
+        });
+    }
+}
+
+void IncrementalEngine::defer(int index) {
+    if (!deferred[index]) {
+        deferred[index] = 1;
+        pending.push_back(index);
+    }
+}
+
+void IncrementalEngine::markSupports(int index, int layer, int position) {
+    int bottomLayer = sg->modelHeight() - 1;
+    for (auto support : sg->getSupports(index)) {
+        int l = sg->getLayerOf(support);
+        if (l == bottomLayer) {
+            // bottom situations are not reasoned about
+            continue;
+        }
+        // layers are evaluated bottom-up, each in topological order
+        if (l < layer || (l == layer && sg->getLayerPosition(support) > position)) {
+            enqueue(support);
+        } else {
+            defer(support);
+        }
+    }
+}
+
+void IncrementalEngine::sweep(Span<int> bottoms, simtime_t current) {
+    int numOfLayers = sg->modelHeight();
+    int bottomLayer = numOfLayers - 1;
+
+    for (auto p : pending) {
+        deferred[p] = 0;
+        enqueue(p);
+    }
+    pending.clear();
+
+    for (auto bottom : bottoms) {
+        markSupports(bottom, bottomLayer, sg->getLayerPosition(bottom));
+    }
+
+    auto later = [this](int a, int b) {
+        return sg->getLayerPosition(a) > sg->getLayerPosition(b);
+    };
+    for (int i = numOfLayers - 1; i > 0; i--) {
+        vector<int>& worklist = worklists[i - 1];
+        while (!worklist.empty()) {
+            pop_heap(worklist.begin(), worklist.end(), later);
+            int upper = worklist.back();
+            worklist.pop_back();
+            queued[upper] = 0;
+
+            if (canTrigger(upper)) {
+                trigger(upper, current);
+                markSupports(upper, i - 1, sg->getLayerPosition(upper));
+                if (canTrigger(upper)) {
+                    defer(upper);
+                }
+            }
+        }
+    }
+}
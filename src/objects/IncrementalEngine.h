@@ -0,0 +1,51 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_INCREMENTALENGINE_H_
+#define OBJECTS_INCREMENTALENGINE_H_
+
+#include <vector>
+#include "ReasoningEngine.h"
+
+/*
+ * Only the upper situations that may change are evaluated in a slice: the
+ * supports of situations triggered in this slice, and those whose
+ * condition still held after they triggered in the last one. Counters
+ * only grow, so any other situation keeps its result, and the outcome is
+ * identical to the full sweep.
+ */
+class IncrementalEngine: public ReasoningEngine {
+private:
+    Mode mode;
+    // per-layer heaps of situations to evaluate in this slice
+    vector<vector<int>> worklists;
+    vector<char> queued;
+    // situations to evaluate in the next slice
+    vector<int> pending;
+    vector<char> deferred;
+
+    bool canTrigger(int index) const;
+    // mark a situation changed while evaluating position (layer, position)
+    void markSupports(int index, int layer, int position);
+    void enqueue(int index);
+    void defer(int index);
+public:
+    explicit IncrementalEngine(Mode mode = BOOLEAN);
+    // every upper situation is evaluated in the first slice after it
+    void attach(SituationReasoner& sr) override;
+    void sweep(Span<int> bottoms, simtime_t current) override;
+};
+
+#endif /* OBJECTS_INCREMENTALENGINE_H_ */
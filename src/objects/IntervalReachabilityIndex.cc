@@ -0,0 +1,225 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <algorithm>
+#include <cstdint>
+#include "IntervalReachabilityIndex.h"
+
+/*
+ * Per-thread scratch space of the fallback search, stamped instead of
+ * cleared between queries.
+ */
+struct SearchScratch {
+    const void* owner = nullptr;
+    uint32_t epoch = 0;
+    vector<uint32_t> marks;
+    vector<int> st;
+};
+
+static thread_local SearchScratch scratch;
+
+IntervalReachabilityIndex::IntervalReachabilityIndex() :
+        ReachabilityIndex() {
+}
+
+void IntervalReachabilityIndex::build(int n,
+        const vector<pair<int, int>>& edges) {
+    this->n = n;
+
+    vector<int> offsets;
+    vector<int> targets;
+    toCSR(n, edges, offsets, targets);
+
+    int size = condense(offsets, targets);
+
+    /*
+     * build the condensation DAG without duplicate edges
+     */
+    cyclic.assign(size, false);
+    vector<int> members(size, 0);
+    for (int v = 0; v < n; v++) {
+        members[component[v]]++;
+    }
+    vector<pair<int, int>> dagEdges;
+    for (int v = 0; v < n; v++) {
+        int c = component[v];
+        if (members[c] > 1) {
+            cyclic[c] = true;
+        }
+        for (int e = offsets[v]; e < offsets[v + 1]; e++) {
+            int d = component[targets[e]];
+            if (d == c) {
+                cyclic[c] = true;
+            } else {
+                dagEdges.push_back(make_pair(c, d));
+            }
+        }
+    }
+    offsets.clear();
+    offsets.shrink_to_fit();
+    targets.clear();
+    targets.shrink_to_fit();
+    sort(dagEdges.begin(), dagEdges.end());
+    dagEdges.erase(unique(dagEdges.begin(), dagEdges.end()), dagEdges.end());
+    toCSR(size, dagEdges, dagOffsets, dagTargets);
+
+    /*
+     * label components by one post-order traversal, starting from the
+     * sources, which carry the highest component numbers
+     */
+    pre.assign(size, -1);
+    post.assign(size, -1);
+    low.assign(size, 0);
+    int preRank = 0;
+    int postRank = 0;
+    // <component, next edge to visit>
+    vector<pair<int, int>> calls;
+    for (int s = size - 1; s >= 0; s--) {
+        if (pre[s] != -1)
+            continue;
+
+        pre[s] = preRank++;
+        low[s] = INT32_MAX;
+        calls.push_back(make_pair(s, dagOffsets[s]));
+        while (!calls.empty()) {
+            int c = calls.back().first;
+            if (calls.back().second < dagOffsets[c + 1]) {
+                int d = dagTargets[calls.back().second++];
+                if (pre[d] == -1) {
+                    pre[d] = preRank++;
+                    low[d] = INT32_MAX;
+                    calls.push_back(make_pair(d, dagOffsets[d]));
+                } else {
+                    low[c] = min(low[c], low[d]);
+                }
+            } else {
+                post[c] = postRank++;
+                low[c] = min(low[c], post[c]);
+                calls.pop_back();
+                if (!calls.empty()) {
+                    int p = calls.back().first;
+                    low[p] = min(low[p], low[c]);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Depth-first search from src, skipping components whose label cannot
+ * contain dest
+ */
+bool IntervalReachabilityIndex::search(int src, int dest) const {
+    int size = post.size();
+    if (scratch.owner != this || (int) scratch.marks.size() != size) {
+        scratch.owner = this;
+        scratch.epoch = 0;
+        scratch.marks.assign(size, 0);
+    }
+    if (++scratch.epoch == 0) {
+        // epoch wrapped around
+        fill(scratch.marks.begin(), scratch.marks.end(), 0);
+        scratch.epoch = 1;
+    }
+
+    vector<int>& st = scratch.st;
+    st.clear();
+    st.push_back(src);
+    scratch.marks[src] = scratch.epoch;
+    while (!st.empty()) {
+        int c = st.back();
+        st.pop_back();
+        for (int e = dagOffsets[c]; e < dagOffsets[c + 1]; e++) {
+            int d = dagTargets[e];
+            if (d == dest || isTreeDescendant(d, dest)) {
+                return true;
+            }
+            if (scratch.marks[d] != scratch.epoch && contains(d, dest)) {
+                scratch.marks[d] = scratch.epoch;
+                st.push_back(d);
+            }
+        }
+    }
+    return false;
+}
+
+bool IntervalReachabilityIndex::isReachable(int src, int dest) const {
+    int cs = component[src];
+    int cd = component[dest];
+    if (cs == cd) {
+        return cyclic[cs];
+    }
+    if (!contains(cs, cd)) {
+        return false;
+    }
+    if (isTreeDescendant(cs, cd)) {
+        return true;
+    }
+    return search(cs, cd);
+}
+
+size_t IntervalReachabilityIndex::memoryUsage() const {
+    return (component.size() + dagOffsets.size() + dagTargets.size()
+            + pre.size() + post.size() + low.size()) * sizeof(int)
+            + cyclic.size() / 8;
+}
+
+void IntervalReachabilityIndex::save(BinaryWriter& out) const {
+    saveComponents(out);
+    out.putArray(dagOffsets);
+    out.putArray(dagTargets);
+    out.putArray(pre);
+    out.putArray(post);
+    out.putArray(low);
+    vector<uint8_t> flags(cyclic.begin(), cyclic.end());
+    out.putArray(flags);
+}
+
+bool IntervalReachabilityIndex::load(BinaryReader& in,
+        shared_ptr<const MappedFile> /* image */) {
+    vector<uint8_t> flags;
+    if (!loadComponents(in) || !in.getArray(dagOffsets)
+            || !in.getArray(dagTargets) || !in.getArray(pre)
+            || !in.getArray(post) || !in.getArray(low) || !in.getArray(flags)) {
+        return false;
+    }
+    size_t size = flags.size();
+    if (dagOffsets.size() != size + 1 || pre.size() != size
+            || post.size() != size || low.size() != size
+            || (size_t) dagOffsets.back() != dagTargets.size()) {
+        return false;
+    }
+    for (int c : component) {
+        if (c < 0 || (size_t) c >= size) {
+            return false;
+        }
+    }
+    for (size_t c = 0; c < size; c++) {
+        if (dagOffsets[c] < 0 || dagOffsets[c] > dagOffsets[c + 1]) {
+            return false;
+        }
+    }
+    for (int d : dagTargets) {
+        if (d < 0 || (size_t) d >= size) {
+            return false;
+        }
+    }
+    cyclic.assign(flags.begin(), flags.end());
+    return true;
+}
+
+IntervalReachabilityIndex::~IntervalReachabilityIndex() {
+
+}
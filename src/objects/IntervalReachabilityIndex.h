@@ -0,0 +1,69 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_INTERVALREACHABILITYINDEX_H_
+#define OBJECTS_INTERVALREACHABILITYINDEX_H_
+
+#include <utility>
+#include <vector>
+#include "ReachabilityIndex.h"
+
+using namespace std;
+
+/*
+ * GRAIL-style interval labeling of the condensation DAG, for graphs whose
+ * transitive closure does not fit in memory.
+ *
+ * A post-order DFS gives every component c the label [low(c), post(c)],
+ * where low(c) is the smallest post-order rank below c, so that
+ * reach(c, d) implies label(d) within label(c). Non-containment answers
+ * "unreachable" at once, a descendant in the DFS spanning tree answers
+ * "reachable" at once, and only the remaining queries fall back to a
+ * search that is pruned by the same label test.
+ *
+ * Memory is linear in vertices plus edges.
+ */
+class IntervalReachabilityIndex: public ReachabilityIndex {
+private:
+    // condensation DAG in CSR layout
+    vector<int> dagOffsets;
+    vector<int> dagTargets;
+    // per component labels
+    vector<int> pre;
+    vector<int> post;
+    vector<int> low;
+    vector<bool> cyclic;
+
+    bool contains(int c, int d) const {
+        return low[c] <= low[d] && post[d] <= post[c];
+    }
+    bool isTreeDescendant(int c, int d) const {
+        return pre[c] < pre[d] && post[d] < post[c];
+    }
+    bool search(int src, int dest) const;
+public:
+    IntervalReachabilityIndex();
+    void build(int n, const vector<pair<int, int>>& edges) override;
+    bool isReachable(int src, int dest) const override;
+    size_t memoryUsage() const override;
+    Strategy getStrategy() const override {
+        return INTERVAL;
+    }
+    void save(BinaryWriter& out) const override;
+    bool load(BinaryReader& in, shared_ptr<const MappedFile> image) override;
+    virtual ~IntervalReachabilityIndex();
+};
+
+#endif /* OBJECTS_INTERVALREACHABILITYINDEX_H_ */
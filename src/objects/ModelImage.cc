@@ -0,0 +1,316 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+#include "../common/BinaryIO.h"
+#include "../common/MappedFile.h"
+#include "ModelImage.h"
+
+static const char MAGIC[4] = { 'D', 'T', 'S', 'G' };
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct ImageHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    // requested reachability strategy
+    uint32_t strategy;
+    // size and modification time of the JSON source
+    int64_t sourceSize;
+    int64_t sourceTime;
+};
+
+struct NodeRecord {
+    int64_t id;
+    double threshold;
+    double duration;
+    double cycle;
+    // number of cause and evidence IDs, as listed in the source
+    int32_t numCauses;
+    int32_t numEvidences;
+};
+
+struct RelationRecord {
+    int64_t src;
+    int64_t dest;
+    int32_t type;
+    int32_t relation;
+    double weight;
+};
+
+/*
+ * Size and modification time of a file, or -1 if it does not exist
+ */
+static void sourceStamp(const string& filename, int64_t& size, int64_t& time) {
+    struct stat st;
+    if (stat(filename.c_str(), &st) == 0) {
+        size = st.st_size;
+        time = st.st_mtime;
+    } else {
+        size = -1;
+        time = -1;
+    }
+}
+
+string ModelImage::imagePath(const string& modelFile) {
+    return modelFile + ".sgb";
+}
+
+bool ModelImage::write(const SituationGraph& model, const string& modelFile,
+        const string& imageFile, ReachabilityIndex::Strategy strategy) {
+    if (!model.ri) {
+        return false;
+    }
+
+    // write to a temporary file, so that readers never see a partial image
+    string tmpFile = imageFile + ".tmp";
+    ofstream os(tmpFile, ios::binary | ios::trunc);
+    if (!os) {
+        return false;
+    }
+    BinaryWriter out(os);
+
+    ImageHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.strategy = strategy;
+    sourceStamp(modelFile, header.sourceSize, header.sourceTime);
+    out.put(header);
+
+    /*
+     * nodes and relations
+     */
+    vector<NodeRecord> nodes;
+    vector<int64_t> causeIds;
+    vector<int64_t> evidenceIds;
+    for (auto& node : model.nodes) {
+        NodeRecord r;
+        r.id = node.id;
+        r.threshold = node.threshold;
+        r.duration = node.duration;
+        r.cycle = node.cycle;
+        r.numCauses = node.causes.size();
+        r.numEvidences = node.evidences.size();
+        nodes.push_back(r);
+        causeIds.insert(causeIds.end(), node.causes.begin(), node.causes.end());
+        evidenceIds.insert(evidenceIds.end(), node.evidences.begin(),
+                node.evidences.end());
+    }
+    out.putArray(nodes);
+    out.putArray(causeIds);
+    out.putArray(evidenceIds);
+    out.putArray(model.causeOffsets);
+    out.putArray(model.causeIndices);
+    out.putArray(model.evidenceOffsets);
+    out.putArray(model.evidenceIndices);
+
+    vector<RelationRecord> relations;
+    for (auto& m : model.relationMap) {
+        const SituationRelation& relation = m.second;
+        RelationRecord r;
+        r.src = relation.src;
+        r.dest = relation.dest;
+        r.type = relation.type;
+        r.relation = relation.relation;
+        r.weight = relation.weight;
+        relations.push_back(r);
+    }
+    out.putArray(relations);
+
+    /*
+     * layers in topological order
+     */
+    out.put<uint32_t>(model.layerOrders.size());
+    for (auto& order : model.layerOrders) {
+        vector<int64_t> ids(order.begin(), order.end());
+        out.putArray(ids);
+    }
+
+    /*
+     * reachability index
+     */
+    out.put<uint32_t>(model.ri->getStrategy());
+    model.ri->save(out);
+
+    os.close();
+    if (!out.good() || os.fail()) {
+        remove(tmpFile.c_str());
+        return false;
+    }
+    remove(imageFile.c_str());
+    return rename(tmpFile.c_str(), imageFile.c_str()) == 0;
+}
+
+static bool validCSR(const vector<int>& offsets, const vector<int>& indices,
+        size_t n) {
+    if (offsets.size() != n + 1 || offsets[0] != 0
+            || (size_t) offsets[n] != indices.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (offsets[i] > offsets[i + 1]) {
+            return false;
+        }
+    }
+    for (int index : indices) {
+        if (index < 0 || (size_t) index >= n) {
+            return false;
+        }
+    }
+    return true;
+}
+
+shared_ptr<SituationGraph> ModelImage::load(const string& modelFile,
+        const string& imageFile, ReachabilityIndex::Strategy strategy) {
+    shared_ptr<MappedFile> image = make_shared<MappedFile>();
+    if (!image->open(imageFile)) {
+        return nullptr;
+    }
+    BinaryReader in(image->data(), image->size());
+
+    ImageHeader header;
+    if (!in.get(header) || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+            || header.version != VERSION
+            || header.byteOrder != BYTE_ORDER_MARK
+            || header.strategy != (uint32_t) strategy) {
+        return nullptr;
+    }
+    int64_t size, time;
+    sourceStamp(modelFile, size, time);
+    // without its source the image is taken as is
+    if (size != -1 && (size != header.sourceSize || time != header.sourceTime)) {
+        return nullptr;
+    }
+
+    shared_ptr<SituationGraph> model = make_shared<SituationGraph>();
+
+    /*
+     * nodes and relations
+     */
+    vector<NodeRecord> nodes;
+    const int64_t* causeIds = nullptr;
+    const int64_t* evidenceIds = nullptr;
+    size_t numCauses = 0, numEvidences = 0;
+    if (!in.getArray(nodes) || !in.view(causeIds, numCauses)
+            || !in.view(evidenceIds, numEvidences)
+            || !in.getArray(model->causeOffsets)
+            || !in.getArray(model->causeIndices)
+            || !in.getArray(model->evidenceOffsets)
+            || !in.getArray(model->evidenceIndices)) {
+        return nullptr;
+    }
+    size_t n = nodes.size();
+    if (!validCSR(model->causeOffsets, model->causeIndices, n)
+            || !validCSR(model->evidenceOffsets, model->evidenceIndices, n)) {
+        return nullptr;
+    }
+    model->nodes.resize(n);
+    size_t c = 0, e = 0;
+    for (size_t i = 0; i < n; i++) {
+        SituationNode& node = model->nodes[i];
+        const NodeRecord& r = nodes[i];
+        if (r.numCauses < 0 || r.numEvidences < 0
+                || numCauses - c < (size_t) r.numCauses
+                || numEvidences - e < (size_t) r.numEvidences) {
+            return nullptr;
+        }
+        node.id = r.id;
+        node.index = i;
+        node.threshold = r.threshold;
+        node.duration = r.duration;
+        node.cycle = r.cycle;
+        node.causes.assign(causeIds + c, causeIds + c + r.numCauses);
+        node.evidences.assign(evidenceIds + e, evidenceIds + e + r.numEvidences);
+        c += r.numCauses;
+        e += r.numEvidences;
+        model->indexMap[node.id] = i;
+    }
+
+    vector<RelationRecord> relations;
+    if (!in.getArray(relations)) {
+        return nullptr;
+    }
+    for (auto& r : relations) {
+        SituationRelation relation;
+        relation.src = r.src;
+        relation.dest = r.dest;
+        relation.type = (SituationRelation::Type) r.type;
+        relation.relation = (SituationRelation::Relation) r.relation;
+        relation.weight = r.weight;
+        model->relationMap[SituationGraph::edge_id(r.src, r.dest)] = relation;
+    }
+
+    /*
+     * layers, rebuilt as when loaded from JSON
+     */
+    uint32_t height = 0;
+    if (!in.get(height) || height == 0 || height > n) {
+        return nullptr;
+    }
+    for (uint32_t l = 0; l < height; l++) {
+        vector<int64_t> ids;
+        if (!in.getArray(ids)) {
+            return nullptr;
+        }
+        vector<long> order;
+        vector<int> indices;
+        for (auto id : ids) {
+            int index = model->indexOf(id);
+            if (index == -1) {
+                return nullptr;
+            }
+            order.push_back(id);
+            indices.push_back(index);
+        }
+
+        set<long> members(order.begin(), order.end());
+        DirectedGraph graph;
+        for (auto id : members) {
+            graph.add_vertex(id);
+            for (auto cause : model->getNode(id).causes) {
+                graph.add_edge(cause, id);
+            }
+        }
+        model->layers.push_back(graph);
+        model->layerOrders.push_back(order);
+        model->layerIndices.push_back(indices);
+    }
+    model->buildSupportArrays();
+    model->buildOperationalArrays();
+    model->buildLevelArrays();
+    model->buildTriggerArrays();
+
+    /*
+     * reachability index, possibly pointing into the mapping
+     */
+    uint32_t concrete = 0;
+    if (!in.get(concrete)
+            || (concrete != ReachabilityIndex::BITSET
+                    && concrete != ReachabilityIndex::INTERVAL)) {
+        return nullptr;
+    }
+    unique_ptr<ReachabilityIndex> index = ReachabilityIndex::create(
+            (ReachabilityIndex::Strategy) concrete, n);
+    if (!index->load(in, image) || index->size() != (int) n) {
+        return nullptr;
+    }
+    model->ri = move(index);
+    model->buildEffectArrays();
+
+    return model;
+}
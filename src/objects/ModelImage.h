@@ -0,0 +1,50 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_MODELIMAGE_H_
+#define OBJECTS_MODELIMAGE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Precompiled, versioned binary image of a situation model: its nodes,
+ * CSR relation arrays, layer orders and reachability index.
+ *
+ * Images are written offline (see tools/sgcompile) and memory-mapped at
+ * load time. A bitset reachability index is used in place from the
+ * mapping; the remaining arrays are linear in the model size and copied.
+ * An image is stale, and ignored, if its format version, byte order or
+ * requested index strategy differ, or if the size or modification time
+ * of its JSON source changed since it was written.
+ */
+class ModelImage {
+public:
+    static const uint32_t VERSION = 2;
+
+    // default image file of a model file
+    static string imagePath(const string& modelFile);
+    static bool write(const SituationGraph& model, const string& modelFile,
+            const string& imageFile, ReachabilityIndex::Strategy strategy);
+    // return nullptr if the image is missing, stale or corrupt
+    static shared_ptr<SituationGraph> load(const string& modelFile,
+            const string& imageFile, ReachabilityIndex::Strategy strategy);
+};
+
+#endif /* OBJECTS_MODELIMAGE_H_ */
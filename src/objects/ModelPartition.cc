@@ -0,0 +1,168 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <algorithm>
+#include <numeric>
+#include "ModelPartition.h"
+
+map<ModelPartition::partition_key, shared_ptr<const ModelPartition>> ModelPartition::partitions;
+mutex ModelPartition::lock;
+
+shared_ptr<const ModelPartition> ModelPartition::get(
+        shared_ptr<const SituationGraph> sg, int n, Grouping grouping) {
+    lock_guard<mutex> guard(lock);
+
+    partition_key key(make_pair(sg.get(), n), grouping);
+    auto it = partitions.find(key);
+    if (it != partitions.end()) {
+        return it->second;
+    }
+
+    shared_ptr<ModelPartition> partition = make_shared<ModelPartition>();
+    partition->sg = sg;
+    partition->build(max(n, 1), grouping);
+    partitions[key] = partition;
+    return partition;
+}
+
+bool ModelPartition::parseGrouping(const string& name, Grouping& grouping) {
+    if (name == "tops") {
+        grouping = TOPS;
+    } else if (name == "components") {
+        grouping = COMPONENTS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static int findRoot(vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void ModelPartition::build(int n, Grouping grouping) {
+    int size = sg->numNodes();
+    Span<int> topLayer = sg->getLayerIndices(0);
+    Span<int> bottomLayer = sg->getLayerIndices(sg->modelHeight() - 1);
+
+    /*
+     * group the top situations
+     */
+    vector<int> parent(size);
+    iota(parent.begin(), parent.end(), 0);
+    vector<char> isTop(size, false);
+    for (auto ti : topLayer) {
+        isTop[ti] = true;
+    }
+    // first top situation over each operational situation
+    vector<int> owner(size, -1);
+    auto unite = [&parent](int a, int b) {
+        parent[findRoot(parent, a)] = findRoot(parent, b);
+    };
+    for (auto ti : topLayer) {
+        for (auto ci : sg->getCauses(ti)) {
+            if (isTop[ci]) {
+                unite(ci, ti);
+            }
+        }
+        for (auto bi : sg->getOperationalSitutionsAt(ti)) {
+            if (owner[bi] == -1) {
+                owner[bi] = ti;
+            } else {
+                unite(owner[bi], ti);
+            }
+        }
+    }
+    if (grouping == COMPONENTS) {
+        // join over all relations, operational situations with their group
+        for (int i = 0; i < size; i++) {
+            for (auto ci : sg->getCauses(i)) {
+                unite(ci, i);
+            }
+            for (auto ei : sg->getEvidences(i)) {
+                unite(ei, i);
+            }
+        }
+        for (auto bi : bottomLayer) {
+            owner[bi] = bi;
+        }
+    }
+
+    // load of each group, its top and operational situations
+    vector<int> load(size, 0);
+    for (auto ti : topLayer) {
+        load[findRoot(parent, ti)]++;
+    }
+    for (auto bi : bottomLayer) {
+        if (owner[bi] != -1) {
+            load[findRoot(parent, owner[bi])]++;
+        }
+    }
+    vector<int> groups;
+    for (int i = 0; i < size; i++) {
+        if (load[i] > 0 && findRoot(parent, i) == i) {
+            groups.push_back(i);
+        }
+    }
+    stable_sort(groups.begin(), groups.end(), [&load](int a, int b) {
+        return load[a] > load[b];
+    });
+
+    /*
+     * deal out the groups, then the operational situations without one
+     */
+    vector<int> partitionLoad(n, 0);
+    vector<int> groupPartition(size, -1);
+    for (auto g : groups) {
+        int k = min_element(partitionLoad.begin(), partitionLoad.end())
+                - partitionLoad.begin();
+        groupPartition[g] = k;
+        partitionLoad[k] += load[g];
+    }
+    partitionOf.assign(size, -1);
+    for (auto ti : topLayer) {
+        partitionOf[ti] = groupPartition[findRoot(parent, ti)];
+    }
+    int next = 0;
+    for (auto bi : bottomLayer) {
+        if (owner[bi] != -1) {
+            partitionOf[bi] = groupPartition[findRoot(parent, owner[bi])];
+        } else if (partitionOf[bi] == -1) {
+            partitionOf[bi] = next++ % n;
+        }
+    }
+
+    auto collect = [this, n](Span<int> layer, vector<int>& offsets,
+            vector<int>& members) {
+        offsets.assign(n + 1, 0);
+        for (auto i : layer) {
+            offsets[partitionOf[i] + 1]++;
+        }
+        for (int k = 0; k < n; k++) {
+            offsets[k + 1] += offsets[k];
+        }
+        members.resize(offsets[n]);
+        vector<int> cursor(offsets.begin(), offsets.end() - 1);
+        for (auto i : layer) {
+            members[cursor[partitionOf[i]]++] = i;
+        }
+    };
+    collect(topLayer, topOffsets, tops);
+    collect(bottomLayer, bottomOffsets, bottoms);
+}
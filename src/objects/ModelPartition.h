@@ -0,0 +1,87 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_MODELPARTITION_H_
+#define OBJECTS_MODELPARTITION_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../common/Span.h"
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Split of the operational situations of a model between a number of
+ * event sources.
+ *
+ * Top situations that share an operational situation, or that are causes
+ * of one another, have to be arranged by the same source and form one
+ * group (TOPS). Sources feeding separate synchronizers, e.g. the shards of
+ * a parallel simulation, need whole components of the situation graph
+ * instead, so that no evidence relation crosses shards (COMPONENTS).
+ * Groups are dealt out largest first to the least loaded partition.
+ * Operational situations without a group are dealt out by index.
+ * Partitions are computed once per model, number of partitions and
+ * grouping, and shared by all sources.
+ */
+class ModelPartition {
+public:
+    enum Grouping {
+        TOPS, COMPONENTS
+    };
+private:
+    typedef pair<pair<const SituationGraph*, int>, Grouping> partition_key;
+    static map<partition_key, shared_ptr<const ModelPartition>> partitions;
+    static mutex lock;
+
+    shared_ptr<const SituationGraph> sg;
+    // partition of each top and operational situation, -1 for the others
+    vector<int> partitionOf;
+    // top and operational situations of each partition in layer order
+    vector<int> topOffsets;
+    vector<int> tops;
+    vector<int> bottomOffsets;
+    vector<int> bottoms;
+
+    void build(int n, Grouping grouping);
+public:
+    static shared_ptr<const ModelPartition> get(
+            shared_ptr<const SituationGraph> sg, int n,
+            Grouping grouping = TOPS);
+    // "tops" or "components"
+    static bool parseGrouping(const string& name, Grouping& grouping);
+
+    int numPartitions() const {
+        return topOffsets.size() - 1;
+    }
+    int getPartitionOf(int index) const {
+        return partitionOf[index];
+    }
+    Span<int> getTops(int k) const {
+        return Span<int>(tops.data() + topOffsets[k],
+                tops.data() + topOffsets[k + 1]);
+    }
+    Span<int> getBottoms(int k) const {
+        return Span<int>(bottoms.data() + bottomOffsets[k],
+                bottoms.data() + bottomOffsets[k + 1]);
+    }
+};
+
+#endif /* OBJECTS_MODELPARTITION_H_ */
@@ -0,0 +1,485 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <omnetpp.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <boost/json/basic_parser_impl.hpp>
+// Boost.JSON is used header-only, compiled into this unit
+#include <boost/json/src.hpp>
+#include "ModelReader.h"
+
+using namespace omnetpp;
+namespace json = boost::json;
+
+// bytes of the model file handed to the parser at a time
+static const size_t CHUNK_SIZE = 1 << 16;
+
+/*
+ * SAX handler building the model. The position in the document is one of
+ * the states below; values of unused keys are skipped by nesting depth.
+ */
+class ModelReader::Handler {
+public:
+    static constexpr size_t max_object_size = size_t(-1);
+    static constexpr size_t max_array_size = size_t(-1);
+    static constexpr size_t max_key_size = size_t(-1);
+    static constexpr size_t max_string_size = size_t(-1);
+
+    // why the handler stopped the parser, empty for syntax errors
+    string error;
+    bool hasLayers;
+private:
+    enum State {
+        START, ROOT, LAYERS, LAYER, NODE, RELATIONS, RELATION, END
+    };
+    struct Scalar {
+        bool null = false;
+        bool integral = false;
+        int64_t integer = 0;
+        double number = 0;
+        // set for strings
+        const char* text = nullptr;
+    };
+
+    SituationGraph& model;
+    set<SituationGraph::edge_id>& edges;
+    State state;
+    // nesting depth inside a skipped value
+    int skip;
+    string key;
+    bool keyDone;
+    string text;
+
+    // node being read and its relations, completed when the node ends
+    SituationNode node;
+    bool hasId, hasDuration, hasCycle;
+    vector<SituationRelation> relations;
+    bool children;
+    SituationRelation relation;
+    bool hasSrc, hasRelation, hasWeight;
+    // first node of the layer being read
+    int layerBegin;
+
+    bool fail(json::error_code& ec, const string& message) {
+        error = message;
+        ec = json::error::syntax;
+        return false;
+    }
+
+    string where() const {
+        return hasId ? "situation " + to_string(node.id)
+                : "situation #" + to_string(model.nodes.size());
+    }
+
+    bool toDouble(const Scalar& value, double& out) {
+        if (value.text) {
+            char* end;
+            out = strtod(value.text, &end);
+            return end != value.text && *end == '\0';
+        }
+        out = value.number;
+        return !value.null;
+    }
+
+    bool toLong(const Scalar& value, long& out) {
+        if (value.text) {
+            char* end;
+            out = strtol(value.text, &end, 10);
+            return end != value.text && *end == '\0';
+        }
+        if (value.integral) {
+            out = value.integer;
+            return true;
+        }
+        out = (long) value.number;
+        return !value.null && out == value.number;
+    }
+
+    bool nodeValue(const Scalar& value, json::error_code& ec) {
+        double number;
+        if (key == "ID") {
+            if (!toLong(value, node.id)) {
+                return fail(ec, where() + ": bad ID");
+            }
+            hasId = true;
+        } else if (key == "Threshold") {
+            if (!toDouble(value, node.threshold)) {
+                return fail(ec, where() + ": bad Threshold");
+            }
+        } else if (key == "Duration") {
+            if (!toDouble(value, number)) {
+                return fail(ec, where() + ": bad Duration");
+            }
+            node.duration = number / 1000.0;
+            hasDuration = true;
+        } else if (key == "Cycle") {
+            if (!value.null && !(value.text && strcmp(value.text, "null") == 0)) {
+                if (!toDouble(value, number)) {
+                    return fail(ec, where() + ": bad Cycle");
+                }
+                // cycle is in millisecond
+                node.cycle = number / 1000.0;
+            }
+            hasCycle = true;
+        } else if ((key == "Predecessors" || key == "Children") && !value.null) {
+            return fail(ec, where() + ": " + key + " is not a list");
+        }
+        return true;
+    }
+
+    bool relationValue(const Scalar& value, json::error_code& ec) {
+        long number;
+        if (key == "ID") {
+            if (!toLong(value, relation.src)) {
+                return fail(ec, where() + ": bad relation ID");
+            }
+            hasSrc = true;
+        } else if (key == "Relation") {
+            if (!toLong(value, number)) {
+                return fail(ec, where() + ": bad Relation");
+            }
+            switch (number) {
+            case 1:
+                relation.relation = SituationRelation::AND;
+                break;
+            case 2:
+                relation.relation = SituationRelation::OR;
+                break;
+            default:
+                relation.relation = SituationRelation::SOLE;
+            }
+            hasRelation = true;
+        } else if (key == (children ? "Weight-y" : "Weight-x")) {
+            if (!toDouble(value, relation.weight)) {
+                return fail(ec, where() + ": bad " + key);
+            }
+            hasWeight = true;
+        }
+        return true;
+    }
+
+    bool scalar(const Scalar& value, json::error_code& ec) {
+        if (skip > 0) {
+            return true;
+        }
+        switch (state) {
+        case ROOT:
+            return true;
+        case NODE:
+            return nodeValue(value, ec);
+        case RELATION:
+            return relationValue(value, ec);
+        default:
+            return fail(ec, "unexpected value in the layers");
+        }
+    }
+
+    bool endRelation(json::error_code& ec) {
+        if (!hasSrc || !hasRelation || !hasWeight) {
+            return fail(ec, where() + ": relation without "
+                    + (!hasSrc ? "ID" : !hasRelation ? "Relation"
+                            : children ? "Weight-y" : "Weight-x"));
+        }
+        relation.type = children ? SituationRelation::V : SituationRelation::H;
+        relations.push_back(relation);
+        return true;
+    }
+
+    bool endNode(json::error_code& ec) {
+        if (!hasId || !hasDuration || !hasCycle) {
+            return fail(ec, where() + ": no "
+                    + (!hasId ? "ID" : !hasDuration ? "Duration" : "Cycle"));
+        }
+        if (model.indexMap.count(node.id)) {
+            return fail(ec, where() + ": duplicate ID");
+        }
+        // the ID may follow the relations in the node
+        for (auto& r : relations) {
+            r.dest = node.id;
+            SituationGraph::edge_id eid(r.src, r.dest);
+            if (r.type == SituationRelation::H) {
+                node.causes.push_back(r.src);
+            } else {
+                node.evidences.push_back(r.src);
+                edges.insert(SituationGraph::edge_id(r.dest, r.src));
+            }
+            model.relationMap[eid] = r;
+            edges.insert(eid);
+        }
+        node.index = model.nodes.size();
+        model.indexMap[node.id] = node.index;
+        model.nodes.push_back(move(node));
+        return true;
+    }
+
+    void endLayer() {
+        // vertices and edges in ID order
+        vector<int> members(model.nodes.size() - layerBegin);
+        iota(members.begin(), members.end(), layerBegin);
+        sort(members.begin(), members.end(), [this](int a, int b) {
+            return model.nodes[a].id < model.nodes[b].id;
+        });
+        DirectedGraph graph;
+        for (int index : members) {
+            const SituationNode& n = model.nodes[index];
+            graph.add_vertex(n.id);
+            for (auto p : n.causes) {
+                graph.add_edge(p, n.id);
+            }
+        }
+        model.layerOrders.push_back(graph.topo_sort());
+        model.layers.push_back(move(graph));
+    }
+
+    void keyPart(json::string_view s) {
+        if (keyDone) {
+            key.clear();
+            keyDone = false;
+        }
+        key.append(s.data(), s.size());
+    }
+public:
+    Handler(SituationGraph& model, set<SituationGraph::edge_id>& edges) :
+            hasLayers(false), model(model), edges(edges), state(START),
+            skip(0), keyDone(true), hasId(false), hasDuration(false),
+            hasCycle(false), children(false), hasSrc(false),
+            hasRelation(false), hasWeight(false), layerBegin(0) {}
+
+    bool on_document_begin(json::error_code& ec) {
+        return true;
+    }
+
+    bool on_document_end(json::error_code& ec) {
+        return true;
+    }
+
+    bool on_object_begin(json::error_code& ec) {
+        if (skip > 0) {
+            skip++;
+            return true;
+        }
+        switch (state) {
+        case START:
+            state = ROOT;
+            break;
+        case LAYER:
+            state = NODE;
+            node = SituationNode();
+            relations.clear();
+            hasId = hasDuration = hasCycle = false;
+            break;
+        case RELATIONS:
+            state = RELATION;
+            relation = SituationRelation();
+            hasSrc = hasRelation = hasWeight = false;
+            break;
+        case ROOT:
+        case NODE:
+        case RELATION:
+            skip = 1;
+            break;
+        default:
+            return fail(ec, "unexpected object in the layers");
+        }
+        return true;
+    }
+
+    bool on_object_end(size_t n, json::error_code& ec) {
+        if (skip > 0) {
+            skip--;
+            return true;
+        }
+        switch (state) {
+        case ROOT:
+            state = END;
+            return true;
+        case NODE:
+            state = LAYER;
+            return endNode(ec);
+        case RELATION:
+            state = RELATIONS;
+            return endRelation(ec);
+        default:
+            return true;
+        }
+    }
+
+    bool on_array_begin(json::error_code& ec) {
+        if (skip > 0) {
+            skip++;
+            return true;
+        }
+        switch (state) {
+        case START:
+            return fail(ec, "the model is not an object");
+        case ROOT:
+            if (key == "layers") {
+                state = LAYERS;
+                hasLayers = true;
+            } else {
+                skip = 1;
+            }
+            break;
+        case LAYERS:
+            state = LAYER;
+            layerBegin = model.nodes.size();
+            break;
+        case NODE:
+            if (key == "Predecessors" || key == "Children") {
+                state = RELATIONS;
+                children = key == "Children";
+            } else {
+                skip = 1;
+            }
+            break;
+        case RELATION:
+            skip = 1;
+            break;
+        default:
+            return fail(ec, "unexpected list in the layers");
+        }
+        return true;
+    }
+
+    bool on_array_end(size_t n, json::error_code& ec) {
+        if (skip > 0) {
+            skip--;
+            return true;
+        }
+        switch (state) {
+        case LAYERS:
+            state = ROOT;
+            break;
+        case LAYER:
+            endLayer();
+            state = LAYERS;
+            break;
+        case RELATIONS:
+            state = NODE;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool on_key_part(json::string_view s, size_t n, json::error_code& ec) {
+        keyPart(s);
+        return true;
+    }
+
+    bool on_key(json::string_view s, size_t n, json::error_code& ec) {
+        keyPart(s);
+        keyDone = true;
+        return true;
+    }
+
+    bool on_string_part(json::string_view s, size_t n, json::error_code& ec) {
+        text.append(s.data(), s.size());
+        return true;
+    }
+
+    bool on_string(json::string_view s, size_t n, json::error_code& ec) {
+        text.append(s.data(), s.size());
+        Scalar value;
+        value.text = text.c_str();
+        bool ok = scalar(value, ec);
+        text.clear();
+        return ok;
+    }
+
+    bool on_number_part(json::string_view s, json::error_code& ec) {
+        return true;
+    }
+
+    bool on_int64(int64_t i, json::string_view s, json::error_code& ec) {
+        Scalar value;
+        value.integral = true;
+        value.integer = i;
+        value.number = i;
+        return scalar(value, ec);
+    }
+
+    bool on_uint64(uint64_t u, json::string_view s, json::error_code& ec) {
+        Scalar value;
+        value.number = u;
+        return scalar(value, ec);
+    }
+
+    bool on_double(double d, json::string_view s, json::error_code& ec) {
+        Scalar value;
+        value.number = d;
+        return scalar(value, ec);
+    }
+
+    bool on_bool(bool b, json::error_code& ec) {
+        Scalar value;
+        value.number = b;
+        return scalar(value, ec);
+    }
+
+    bool on_null(json::error_code& ec) {
+        Scalar value;
+        value.null = true;
+        return scalar(value, ec);
+    }
+
+    bool on_comment_part(json::string_view s, json::error_code& ec) {
+        return true;
+    }
+
+    bool on_comment(json::string_view s, json::error_code& ec) {
+        return true;
+    }
+};
+
+void ModelReader::read(const string& filename, SituationGraph& model,
+        set<SituationGraph::edge_id>& edges) {
+    ifstream is(filename, ios::binary);
+    if (!is) {
+        throw cRuntimeError("Cannot open model file '%s'", filename.c_str());
+    }
+
+    json::basic_parser<Handler> parser(json::parse_options(), model, edges);
+    json::error_code ec;
+    vector<char> chunk(CHUNK_SIZE);
+    while (!ec && is) {
+        is.read(chunk.data(), chunk.size());
+        parser.write_some(true, chunk.data(), is.gcount(), ec);
+    }
+    if (!ec && is.bad()) {
+        throw cRuntimeError("Cannot read model file '%s'", filename.c_str());
+    }
+    if (!ec) {
+        // end of the document
+        parser.write_some(false, nullptr, 0, ec);
+    }
+
+    const Handler& handler = parser.handler();
+    if (ec) {
+        throw cRuntimeError("Malformed model file '%s': %s", filename.c_str(),
+                handler.error.empty() ? ec.message().c_str()
+                        : handler.error.c_str());
+    }
+    if (!handler.hasLayers) {
+        throw cRuntimeError("Malformed model file '%s': no layers",
+                filename.c_str());
+    }
+}
@@ -0,0 +1,44 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_MODELREADER_H_
+#define OBJECTS_MODELREADER_H_
+
+#include <set>
+#include <string>
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Streaming reader of SG.json models.
+ *
+ * The file is fed in fixed-size chunks to a boost::json SAX parser, and
+ * nodes, relations and layers are stored into the model as their values
+ * are parsed, without an intermediate document tree, so that peak memory
+ * is that of the model itself. Keys the model does not use are skipped,
+ * numbers may also be given as strings, and a null or "null" Cycle
+ * leaves the situation without a cycle.
+ */
+class ModelReader {
+private:
+    class Handler;
+public:
+    // read the nodes and layers of a model, throws cRuntimeError if malformed
+    static void read(const string& filename, SituationGraph& model,
+            set<SituationGraph::edge_id>& edges);
+};
+
+#endif /* OBJECTS_MODELREADER_H_ */
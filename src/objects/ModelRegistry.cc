@@ -0,0 +1,48 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include "ModelImage.h"
+#include "ModelRegistry.h"
+
+map<ModelRegistry::model_key, shared_ptr<const SituationGraph>> ModelRegistry::models;
+mutex ModelRegistry::lock;
+
+shared_ptr<const SituationGraph> ModelRegistry::get(const string& filename,
+        ReachabilityIndex::Strategy strategy, bool useImage) {
+    lock_guard<mutex> guard(lock);
+
+    model_key key(filename, strategy);
+    auto it = models.find(key);
+    if (it != models.end()) {
+        return it->second;
+    }
+
+    shared_ptr<SituationGraph> model;
+    if (useImage) {
+        model = ModelImage::load(filename, ModelImage::imagePath(filename),
+                strategy);
+    }
+    if (!model) {
+        model = make_shared<SituationGraph>();
+        model->loadModel(filename, strategy);
+    }
+    models[key] = model;
+    return model;
+}
+
+void ModelRegistry::clear() {
+    lock_guard<mutex> guard(lock);
+    models.clear();
+}
@@ -0,0 +1,48 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_MODELREGISTRY_H_
+#define OBJECTS_MODELREGISTRY_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Process-wide cache of loaded situation models.
+ *
+ * Each model file is parsed and indexed once per index strategy, and then
+ * shared read-only by all modules and all repetitions run in the same
+ * process. If a current precompiled image of the model is found next to
+ * the model file, it is mapped instead of parsing the JSON.
+ */
+class ModelRegistry {
+private:
+    typedef pair<string, ReachabilityIndex::Strategy> model_key;
+    static map<model_key, shared_ptr<const SituationGraph>> models;
+    static mutex lock;
+public:
+    static shared_ptr<const SituationGraph> get(const string& filename,
+            ReachabilityIndex::Strategy strategy = ReachabilityIndex::AUTO,
+            bool useImage = true);
+    // drop all cached models, those still held by modules stay alive
+    static void clear();
+};
+
+#endif /* OBJECTS_MODELREGISTRY_H_ */
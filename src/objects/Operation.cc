@@ -15,12 +15,7 @@
 
 #include "Operation.h"
 
-Operation::Operation() {
-    id = 0;
-    timestamp = 0;
+ostream& operator<<(ostream& os, const Operation& o) {
+    os << "Operation [" << o.id << "]: timestamp " << o.getTimestamp();
+    return os;
 }
-
-Operation::~Operation() {
-    // TODO Auto-generated destructor stub
-}
-
@@ -17,26 +17,35 @@
 #define OBJECTS_OPERATION_H_
 
 #include <omnetpp.h>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
 
 using namespace std;
 using namespace omnetpp;
 
-class Operation {
-public:
-    long id;
-    simtime_t timestamp;
-protected:
-    // print has to be a constant method, as the caller is a constant
-    virtual void print(ostream& os) const{
-        os << "Operation [" << id << "]: timestamp " << timestamp;
+/*
+ * Operations are plain records: no virtual functions, and the timestamp
+ * kept as a raw simtime_t value. The derived records stay trivially
+ * copyable, so the vectors of them a tick or slice fills are copied with
+ * memcpy and sorted and scanned without indirection. Printing goes through
+ * the operator<< overloads of each record instead of a virtual print.
+ */
+struct Operation {
+    long id = 0;
+    // raw value of the timestamp, see getTimestamp
+    int64_t time = 0;
+
+    simtime_t getTimestamp() const {
+        return SimTime::fromRaw(time);
     }
-    friend ostream& operator<<(ostream &os, const Operation &o) {
-        o.print(os);
-        return os;
+    void setTimestamp(simtime_t timestamp) {
+        time = timestamp.raw();
     }
-public:
-    Operation();
-    virtual ~Operation();
 };
 
+ostream& operator<<(ostream& os, const Operation& o);
+
+static_assert(is_trivially_copyable<Operation>::value, "Operation is a record");
+
 #endif /* OBJECTS_OPERATION_H_ */
@@ -13,137 +13,499 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include <algorithm>
+#include <map>
+#include "../common/Logging.h"
 #include "../common/Util.h"
 #include "OperationGenerator.h"
 
 OperationGenerator::OperationGenerator() {
-
+    se = nullptr;
+    triggers = nullptr;
+    queueCapacity = 0;
+    overflowPolicy = DROP_OLDEST;
+    mergePolicy = FIRST;
+    compensation = true;
+    mergeTime = 0;
+    sortTime = 0;
 }
 
-void OperationGenerator::setModel(SituationGraph sg){
+void OperationGenerator::setModel(shared_ptr<const SituationGraph> sg){
     this->sg = sg;
+    eventQueues.assign(sg->numNodes(),
+            RingBuffer<OperationalEvent>(queueCapacity));
+    tallies.assign(sg->numNodes(), Tally());
+    activeQueues.clear();
 }
 
 void OperationGenerator::setModelInstance(SituationEvolution* se){
     this->se = se;
 }
 
-void OperationGenerator::cacheEvent(long eventId, bool toTrigger,
+void OperationGenerator::setTriggerBuffer(TriggerBuffer* triggers){
+    this->triggers = triggers;
+}
+
+void OperationGenerator::setQueueCapacity(size_t capacity,
+        OverflowPolicy policy) {
+    queueCapacity = capacity;
+    overflowPolicy = policy;
+    for (size_t i = 0; i < eventQueues.size(); i++) {
+        // shrinking drops the oldest events
+        eventQueues[i].setCapacity(capacity);
+        recount(i);
+    }
+}
+
+bool OperationGenerator::parseOverflowPolicy(const string& name,
+        OverflowPolicy& policy) {
+    if (name == "dropOldest") {
+        policy = DROP_OLDEST;
+    } else if (name == "coalesce") {
+        policy = COALESCE;
+    } else if (name == "backpressure") {
+        policy = BACKPRESSURE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void OperationGenerator::setMergePolicy(MergePolicy policy) {
+    mergePolicy = policy;
+}
+
+OperationGenerator::MergePolicy OperationGenerator::getMergePolicy() const {
+    return mergePolicy;
+}
+
+bool OperationGenerator::parseMergePolicy(const string& name,
+        MergePolicy& policy) {
+    if (name == "first") {
+        policy = FIRST;
+    } else if (name == "lastWriterWins") {
+        policy = LAST_WRITER_WINS;
+    } else if (name == "countAggregate") {
+        policy = COUNT_AGGREGATE;
+    } else if (name == "toggleCancel") {
+        policy = TOGGLE_CANCEL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool OperationGenerator::mergeEvents(int index, OperationalEvent& merged) {
+    RingBuffer<OperationalEvent>& queue = eventQueues[index];
+    Tally& tally = tallies[index];
+    if (mergePolicy == FIRST) {
+        merged = queue.front();
+        queue.pop_front();
+        tally.triggers -= merged.toTrigger;
+        return true;
+    }
+    // the other policies drain the queue
+    tally = Tally();
+
+    int count = queue.size();
+    switch (mergePolicy) {
+    case LAST_WRITER_WINS:
+        merged = queue.front();
+        for (auto& event : queue) {
+            if (event.time >= merged.time) {
+                merged = event;
+            }
+        }
+        break;
+    case COUNT_AGGREGATE: {
+        bool toTrigger = false;
+        for (auto& event : queue) {
+            toTrigger = toTrigger || event.toTrigger;
+        }
+        merged = queue.back();
+        merged.toTrigger = toTrigger;
+        break;
+    }
+    case TOGGLE_CANCEL: {
+        // cancel trigger/release pairs in arrival order
+        int kept = 0;
+        for (size_t i = 0; i < queue.size(); i++) {
+            if (!queue[i].toTrigger && kept > 0 && queue[kept - 1].toTrigger) {
+                kept--;
+            } else {
+                queue[kept++] = queue[i];
+            }
+        }
+        // releases left over precede the triggers and cancel nothing
+        int first = 0;
+        while (first < kept && !queue[first].toTrigger) {
+            first++;
+        }
+        if (first == kept) {
+            queue.clear();
+            return false;
+        }
+        merged = queue[kept - 1];
+        count = kept - first;
+        break;
+    }
+    default:
+        break;
+    }
+    merged.merged = count;
+    queue.clear();
+    return true;
+}
+
+void OperationGenerator::setCompensation(bool compensation) {
+    this->compensation = compensation;
+}
+
+void OperationGenerator::count(Tally& tally, const OperationalEvent& event,
+        bool first) {
+    tally.triggers += event.toTrigger;
+    if (event.toTrigger) {
+        tally.open++;
+    } else if (tally.open > 0) {
+        tally.open--;
+    }
+    if (first || event.time >= tally.latest) {
+        tally.latest = event.time;
+        tally.latestTriggers = event.toTrigger;
+    }
+}
+
+void OperationGenerator::recount(int index) {
+    Tally& tally = tallies[index];
+    tally = Tally();
+    bool first = true;
+    for (auto& event : eventQueues[index]) {
+        count(tally, event, first);
+        first = false;
+    }
+}
+
+void OperationGenerator::updateTriggers(int index, bool toTrigger) {
+    if (triggers) {
+        if (toTrigger) {
+            triggers->add(sg->idAt(index));
+        }
+        triggers->limit(index, pendingTriggers(index));
+    }
+}
+
+int OperationGenerator::pendingTriggers(int index) const {
+    const Tally& tally = tallies[index];
+    switch (mergePolicy) {
+    case FIRST:
+        return tally.triggers;
+    case LAST_WRITER_WINS:
+        return !eventQueues[index].empty() && tally.latestTriggers;
+    case COUNT_AGGREGATE:
+        return tally.triggers > 0;
+    case TOGGLE_CANCEL:
+        return tally.open > 0;
+    }
+    return 0;
+}
+
+bool OperationGenerator::cacheEvent(long eventId, bool toTrigger,
         simtime_t timestamp) {
+    int index = sg->indexOf(eventId);
+    if (index == -1) {
+        throw cRuntimeError("Event for unknown situation %ld", eventId);
+    }
+
     OperationalEvent event;
     event.id = eventId;
+    // operational situations are the bottom layer, one variable each
+    event.svId = sg->getLayerPosition(index);
     event.toTrigger = toTrigger;
-    event.timestamp = timestamp;
-    eventQueues[eventId].push_back(event);
+    event.setTimestamp(timestamp);
+
+    RingBuffer<OperationalEvent>& queue = eventQueues[index];
+    if (queue.full()) {
+        switch (overflowPolicy) {
+        case DROP_OLDEST:
+            queue.pop_front();
+            queue.push_back(event);
+            recount(index);
+            updateTriggers(index, toTrigger);
+            return true;
+        case COALESCE:
+            // the newest cached event takes over the new state
+            queue.back() = event;
+            recount(index);
+            updateTriggers(index, toTrigger);
+            return true;
+        case BACKPRESSURE:
+            return false;
+        }
+    }
+    queue.push_back(event);
+    count(tallies[index], event, queue.size() == 1);
+    updateTriggers(index, toTrigger);
+
+    if (queue.size() == 1) {
+        // first use of this queue, keep the active list ordered by ID
+        auto it = lower_bound(activeQueues.begin(), activeQueues.end(), index,
+                [this](int a, int b) {
+                    return sg->idAt(a) < sg->idAt(b);
+                });
+        if (it == activeQueues.end() || *it != index) {
+            activeQueues.insert(it, index);
+        }
+    }
+    return true;
 }
 
-queue<vector<VirtualOperation>> OperationGenerator::generateOperations(set<long> cycleTriggered) {
+void OperationGenerator::generateOperations(const SituationSet& cycleTriggered,
+        OperationSets& opSets) {
     /*
-     * Event merge: here is only an over-simplified implementation
+     * Event merge, see MergePolicy
      */
-    map<long, OperationalEvent> mergedEvents;
-    set<long> toRemoveFront;
-    for(auto a : eventQueues){
-        long id = a.first;
-        if(!a.second.empty()){
-            OperationalEvent event = a.second[0];
-            mergedEvents[id] = event;
-            toRemoveFront.insert(id);
-        }
-    }
+    pmr::map<long, OperationalEvent> mergedEvents(
+            opSets.get_allocator().resource());
 
     //    cout << "mergedEvents: ";
     //    util::printMap(mergedEvents);
+    if (DT_LOG_ENABLED(DT_LOG_TRACE)) {
         cout << "print eventQueues: " << endl;
-        util::printComplexMap(eventQueues);
+        for(auto index : activeQueues){
+            cout << sg->idAt(index) << ": ";
+            util::printContainer(eventQueues[index]);
+            cout << endl;
+        }
+    }
 
-    // to remove the first event from cache, which is supposed to be transmitted to simulator
-    for(auto a : toRemoveFront){
-        eventQueues[a].erase(eventQueues[a].begin());
+    timer.begin();
+    // merge the cached events of each situation in one pass, the merged event is transmitted to simulator
+    for(auto index : activeQueues){
+        OperationalEvent merged;
+        if(!eventQueues[index].empty() && mergeEvents(index, merged)){
+            mergedEvents[merged.id] = merged;
+        }
     }
 
     /*
-     * TODO use cycleTriggered to generate events for sync failure, and add them to mergedEvents
+     * Sync failure: operational situations inferred in this cycle without a
+     * cached event, e.g. lost on the way, are compensated. Both sides are
+     * ordered by ID, so one merge walk finds the difference.
      */
+    if(compensation){
+        auto merged = mergedEvents.begin();
+        for(auto id : cycleTriggered){
+            while(merged != mergedEvents.end() && merged->first < id){
+                ++merged;
+            }
+            if(merged != mergedEvents.end() && merged->first == id){
+                continue;
+            }
+            int index = sg->indexOf(id);
+            if(index == -1){
+                continue;
+            }
+            OperationalEvent event;
+            event.id = id;
+            event.svId = sg->getLayerPosition(index);
+            event.toTrigger = true;
+            // start time of the situation as inferred by the reasoner
+            event.setTimestamp(se->getInstanceAt(index).next_start);
+            event.merged = 0;
+            event.compensating = true;
+            mergedEvents.insert(merged, make_pair(id, event));
+        }
+    }
+    mergeTime = timer.end();
 
     /*
-     * Event sort
+     * Event sort: an operation waits for its causes, i.e. the operations
+     * that strictly reach it and were triggered in the same slice (same
+     * counter). Operations without a cause go first, then those with one
+     * by decreasing height, the longest chain of effects they cause.
+     *
+     * The operations of one component of the model and one counter have
+     * the same causes and effects, so the sort runs over these groups, with
+     * edges taken from the effect components of the model.
      */
-    stack<map<long, VirtualOperation>> sorted;
-    map<long, VirtualOperation> voMap;
-    for(auto a : mergedEvents){
+    timer.begin();
+    sortOps.clear();
+    sortGroups.clear();
+    groupComponents.clear();
+    groupCounts.clear();
+    groupNext.clear();
+    componentGroups.resize(sg->numComponents(), -1);
+    for(auto& a : mergedEvents){
         VirtualOperation vo;
         vo.id = a.first;
-        vo.timestamp = a.second.timestamp;
-        vo.count = se->getInstance(a.first).counter;
-        voMap[vo.id] = vo;
-    }
-    sorted.push(voMap);
-
-    bool hasCause = false;
-    do{
-        hasCause = false;
-        map<long, VirtualOperation>& topMap = sorted.top();
-        map<long, VirtualOperation> newVoMap;
-        for(auto vo : topMap){
-            long id = vo.first;
-            SituationNode node = sg.getNode(id);
-            SituationInstance& instance = se->getInstance(id);
-
-            /*
-             * search for vo's cause situations
-             */
-            // a flag indicating whether a situation has a cause in the same slice
-            bool sameSlice = false;
-            for(auto& vo1 : topMap){
-                if(vo1.first != id && sg.isReachable(vo1.first, id) && !sg.isReachable(id, vo1.first)){
-                    SituationInstance& cInstance = se->getInstance(vo1.first);
-                    /*
-                     * check whether causes have been triggered in the last time slice
-                     */
-                    if(cInstance.counter == instance.counter){
-                        newVoMap[vo1.first] = vo1.second;
-                        sameSlice = true;
-                        hasCause = true;
-//                        cout << "find cause situation (" << vo.second << ")'s cause (" << vo1.second << endl;
-                    }
+        vo.time = a.second.time;
+        vo.svId = a.second.svId;
+        int index = sg->indexOf(vo.id);
+        vo.count = se->getCounterAt(index);
+        sortOps.push_back(vo);
+
+        int c = sg->getComponentAt(index);
+        int g = componentGroups[c];
+        while(g != -1 && groupCounts[g] != vo.count){
+            g = groupNext[g];
+        }
+        if(g == -1){
+            g = groupComponents.size();
+            groupComponents.push_back(c);
+            groupCounts.push_back(vo.count);
+            groupNext.push_back(componentGroups[c]);
+            componentGroups[c] = g;
+        }
+        sortGroups.push_back(g);
+    }
+    int k = sortOps.size();
+    int n = groupComponents.size();
+
+    // cause -> effect edges among the groups
+    succOffsets.assign(n + 1, 0);
+    succTargets.clear();
+    predCounts.assign(n, 0);
+    for(int a = 0; a < n; a++){
+        for(auto d : sg->getEffectComponents(groupComponents[a])){
+            for(int b = componentGroups[d]; b != -1; b = groupNext[b]){
+                if(groupCounts[b] == groupCounts[a]){
+                    succTargets.push_back(b);
+                    predCounts[b]++;
                 }
             }
-            if(!sameSlice){
-                // migrate causes and no-cause operations to a new operation set
-                newVoMap[id] = vo.second;
-            }
-
         }
+        succOffsets[a + 1] = succTargets.size();
+    }
+    // leave the lookup clear for the next slice
+    for(auto c : groupComponents){
+        componentGroups[c] = -1;
+    }
 
-        if(hasCause){
-            sorted.push(newVoMap);
-            // delete causes and no-cause events from the checked Set
-            for(auto vo : newVoMap){
-                topMap.erase(vo.first);
+    // heights in reverse topological order, Kahn over the reversed edges
+    predOffsets.assign(n + 1, 0);
+    for(int b = 0; b < n; b++){
+        predOffsets[b + 1] = predOffsets[b] + predCounts[b];
+    }
+    predSources.resize(succTargets.size());
+    sortCursor.assign(predOffsets.begin(), predOffsets.end() - 1);
+    for(int a = 0; a < n; a++){
+        for(int e = succOffsets[a]; e < succOffsets[a + 1]; e++){
+            predSources[sortCursor[succTargets[e]]++] = a;
+        }
+    }
+    heights.assign(n, 0);
+    sortCursor.resize(n);
+    sortReady.clear();
+    for(int a = 0; a < n; a++){
+        // remaining effects
+        sortCursor[a] = succOffsets[a + 1] - succOffsets[a];
+        if(sortCursor[a] == 0){
+            sortReady.push_back(a);
+        }
+    }
+    int maxHeight = -1;
+    while(!sortReady.empty()){
+        int b = sortReady.back();
+        sortReady.pop_back();
+        if(predCounts[b] > 0 && heights[b] > maxHeight){
+            maxHeight = heights[b];
+        }
+        for(int e = predOffsets[b]; e < predOffsets[b + 1]; e++){
+            int a = predSources[e];
+            if(heights[b] + 1 > heights[a]){
+                heights[a] = heights[b] + 1;
+            }
+            if(--sortCursor[a] == 0){
+                sortReady.push_back(a);
             }
+        }
+    }
 
-            cout << "migrate operation set" << endl;
+    /*
+     * Divide events into different sets, one without causes and one per
+     * height of those with, none at all without events
+     */
+    // the batches take the allocator of opSets
+    opSets.clear();
+    opSets.resize(k == 0 ? 0 : maxHeight + 2);
+    for(int a = 0; a < k; a++){
+        int g = sortGroups[a];
+        if(predCounts[g] == 0){
+            opSets[0].push_back(sortOps[a]);
+        } else {
+            opSets[1 + maxHeight - heights[g]].push_back(sortOps[a]);
         }
+    }
+    for(int h = 0; h <= maxHeight; h++){
+        LOG_TRACE << "migrate operation set" << endl;
+    }
+    sortTime = timer.end();
+}
 
-    }while(hasCause);
+size_t OperationGenerator::queuedEvents() const {
+    size_t count = 0;
+    for(auto index : activeQueues){
+        count += eventQueues[index].size();
+    }
+    return count;
+}
 
+void OperationGenerator::save(BinaryWriter& out) const {
+    uint32_t count = 0;
+    for (auto index : activeQueues) {
+        count += !eventQueues[index].empty();
+    }
+    out.put(count);
+    vector<OperationalEvent> events;
+    for (auto index : activeQueues) {
+        const RingBuffer<OperationalEvent>& queue = eventQueues[index];
+        if (!queue.empty()) {
+            events.assign(queue.begin(), queue.end());
+            out.put<int32_t>(index);
+            out.putArray(events);
+        }
+    }
+}
 
-    /*
-     * Divide events into different sets
-     */
-    queue<vector<VirtualOperation>> opSets;
-    while(!sorted.empty()){
-        map<long, VirtualOperation>& voMap = sorted.top();
-        vector<VirtualOperation> operations;
-        for(auto a : voMap){
-            operations.push_back(a.second);
+bool OperationGenerator::load(BinaryReader& in, simtime_t shift) {
+    for (auto index : activeQueues) {
+        eventQueues[index].clear();
+        tallies[index] = Tally();
+    }
+    activeQueues.clear();
+
+    uint32_t count = 0;
+    if (!in.get(count)) {
+        return false;
+    }
+    vector<OperationalEvent> events;
+    for (uint32_t q = 0; q < count; q++) {
+        int32_t index = -1;
+        if (!in.get(index) || index < 0 || index >= sg->numNodes()
+                || !in.getArray(events)) {
+            return false;
         }
-        opSets.push(operations);
-        sorted.pop();
+        RingBuffer<OperationalEvent>& queue = eventQueues[index];
+        for (auto& event : events) {
+            if (queue.full()) {
+                queue.pop_front();
+            }
+            event.setTimestamp(event.getTimestamp() - shift);
+            queue.push_back(event);
+        }
+        recount(index);
+        activeQueues.push_back(index);
     }
+    sort(activeQueues.begin(), activeQueues.end(), [this](int a, int b) {
+        return sg->idAt(a) < sg->idAt(b);
+    });
+    activeQueues.erase(unique(activeQueues.begin(), activeQueues.end()),
+            activeQueues.end());
+    return true;
+}
 
-    return opSets;
+void OperationGenerator::setStageTiming(bool enabled) {
+    timer.setEnabled(enabled);
 }
 
 OperationGenerator::~OperationGenerator() {
@@ -16,24 +16,154 @@
 #ifndef OBJECTS_OPERATIONGENERATOR_H_
 #define OBJECTS_OPERATIONGENERATOR_H_
 
+#include <memory>
+#include <memory_resource>
+#include <string>
 #include <vector>
-#include <queue>
+#include "../common/BinaryIO.h"
+#include "../common/RingBuffer.h"
+#include "../common/StageTimer.h"
 #include "SituationGraph.h"
 #include "SituationEvolution.h"
 #include "OperationalEvent.h"
+#include "TriggerBuffer.h"
 #include "VirtualOperation.h"
 
+// operations migrated together, and the sets of a slice in order
+typedef pmr::vector<VirtualOperation> OperationSet;
+typedef pmr::vector<OperationSet> OperationSets;
+
 class OperationGenerator {
+public:
+    // what cacheEvent does when a situation's event queue is full
+    enum OverflowPolicy {
+        // discard the oldest cached event
+        DROP_OLDEST,
+        // fold the new event into the newest cached one
+        COALESCE,
+        // reject the new event, the caller has to offer it again later
+        BACKPRESSURE
+    };
+    // how the events cached for a situation are merged in a slice
+    enum MergePolicy {
+        // take the oldest event only, the rest waits for later slices
+        FIRST,
+        // drain the queue, the event with the latest timestamp wins
+        LAST_WRITER_WINS,
+        // drain the queue into its latest event, which triggers if any did
+        COUNT_AGGREGATE,
+        // drain the queue, cancelling each trigger followed by a release,
+        // and drop the releases left over
+        TOGGLE_CANCEL
+    };
 private:
-    SituationGraph sg;
+    // what the events of a queue add up to, see pendingTriggers
+    struct Tally {
+        // triggering events
+        int triggers = 0;
+        // triggers left once trigger/release pairs cancel
+        int open = 0;
+        // the event with the latest timestamp, the last of equal ones
+        int64_t latest = 0;
+        bool latestTriggers = false;
+    };
+
+    shared_ptr<const SituationGraph> sg;
     SituationEvolution* se;
-    map<long, vector<OperationalEvent>> eventQueues;
+    // cached events by dense index
+    vector<RingBuffer<OperationalEvent>> eventQueues;
+    vector<Tally> tallies;
+    // triggers of the cached events, if set
+    TriggerBuffer* triggers;
+    // indices of the queues in use, ordered by situation ID
+    vector<int> activeQueues;
+    size_t queueCapacity;
+    OverflowPolicy overflowPolicy;
+    MergePolicy mergePolicy;
+    bool compensation;
+    // scratch space of the event sort, reused across slices
+    vector<VirtualOperation> sortOps;
+    // group of each operation, and component, counter and next group of
+    // the same component of each group
+    vector<int> sortGroups;
+    vector<int> groupComponents;
+    vector<int> groupCounts;
+    vector<int> groupNext;
+    // first group of each component of the model, -1 between slices
+    vector<int> componentGroups;
+    vector<int> succOffsets;
+    vector<int> succTargets;
+    vector<int> predOffsets;
+    vector<int> predSources;
+    vector<int> predCounts;
+    vector<int> heights;
+    vector<int> sortCursor;
+    vector<int> sortReady;
+    // cost of the last merge and sort, in seconds of wall-clock time
+    StageTimer timer;
+    double mergeTime;
+    double sortTime;
+
+    // return false if nothing is left of the queue's events
+    bool mergeEvents(int index, OperationalEvent& merged);
+    static void count(Tally& tally, const OperationalEvent& event, bool first);
+    // tally a queue from scratch, after events left it other than by merge
+    void recount(int index);
+    void updateTriggers(int index, bool toTrigger);
 public:
     OperationGenerator();
-    void setModel(SituationGraph sg);
+    void setModel(shared_ptr<const SituationGraph> sg);
     void setModelInstance(SituationEvolution* se);
-    void cacheEvent(long eventId, bool toTrigger, simtime_t timestamp);
-    queue<vector<VirtualOperation>> generateOperations(set<long> cycleTriggered);
+    /*
+     * Keep the triggers of the cached events in a buffer, not owned: one is
+     * added per triggering event cached, and each situation's count is
+     * limited to pendingTriggers wherever an overflow or a merge drops,
+     * folds or cancels its events.
+     */
+    void setTriggerBuffer(TriggerBuffer* triggers);
+    // capacity 0 leaves the queues unbounded
+    void setQueueCapacity(size_t capacity, OverflowPolicy policy);
+    // "dropOldest", "coalesce" or "backpressure"
+    static bool parseOverflowPolicy(const string& name, OverflowPolicy& policy);
+    void setCompensation(bool compensation);
+    void setMergePolicy(MergePolicy policy);
+    MergePolicy getMergePolicy() const;
+    // "first", "lastWriterWins", "countAggregate" or "toggleCancel"
+    static bool parseMergePolicy(const string& name, MergePolicy& policy);
+    // return false if the event was rejected by backpressure
+    bool cacheEvent(long eventId, bool toTrigger, simtime_t timestamp);
+    /*
+     * Slices the cached events of a situation still trigger it in with the
+     * merge policy: one per triggering event with FIRST, at most one with
+     * the policies that drain the queue, none if the drained queue merges
+     * into a release or all its triggers are cancelled.
+     */
+    int pendingTriggers(int index) const;
+    /*
+     * Merge cached events into batches of virtual operations, and with
+     * compensation on, synthesize one for each situation the reasoner
+     * inferred in this cycle (cycleTriggered) that no event arrived for.
+     * The batches replace the content of opSets, and the temporaries of
+     * the merge come from its memory resource as well.
+     */
+    void generateOperations(const SituationSet& cycleTriggered,
+            OperationSets& opSets);
+    // events currently cached over all queues
+    size_t queuedEvents() const;
+    /*
+     * Write the cached events for a RuntimeSnapshot, and restore them with
+     * their timestamps moved back by shift. The oldest events beyond the
+     * queue capacity are dropped.
+     */
+    void save(BinaryWriter& out) const;
+    bool load(BinaryReader& in, simtime_t shift);
+    void setStageTiming(bool enabled);
+    double getMergeTime() const {
+        return mergeTime;
+    }
+    double getSortTime() const {
+        return sortTime;
+    }
     virtual ~OperationGenerator();
 };
 
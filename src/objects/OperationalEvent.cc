@@ -15,13 +15,8 @@
 
 #include "OperationalEvent.h"
 
-OperationalEvent::OperationalEvent() :
-        Operation() {
-    svId = 0;
-    toTrigger = false;
+ostream& operator<<(ostream& os, const OperationalEvent& e) {
+    os << (const Operation&) e << " svID " << e.svId << " toTrigger "
+            << e.toTrigger;
+    return os;
 }
-
-OperationalEvent::~OperationalEvent() {
-    // TODO Auto-generated destructor stub
-}
-
@@ -18,20 +18,19 @@
 
 #include "Operation.h"
 
-class OperationalEvent: public Operation {
-public:
+struct OperationalEvent: public Operation {
     // state variable ID
-    long svId;
-    bool toTrigger;
-protected:
-    // print has to be a constant method, as the caller is a constant
-    void print(ostream &os) const {
-        Operation::print(os);
-        os << " svID " << svId << " toTrigger " << toTrigger;
-    }
-public:
-    OperationalEvent();
-    virtual ~OperationalEvent();
+    long svId = 0;
+    // number of cached events merged into this one
+    int merged = 1;
+    bool toTrigger = false;
+    // synthesized for a situation inferred without an event
+    bool compensating = false;
 };
 
+ostream& operator<<(ostream& os, const OperationalEvent& e);
+
+static_assert(is_trivially_copyable<OperationalEvent>::value,
+        "OperationalEvent is a record");
+
 #endif /* OBJECTS_OPERATIONALEVENT_H_ */
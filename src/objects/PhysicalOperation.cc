@@ -15,12 +15,7 @@
 
 #include "PhysicalOperation.h"
 
-PhysicalOperation::PhysicalOperation() :
-        Operation() {
-    toTrigger = false;
+ostream& operator<<(ostream& os, const PhysicalOperation& o) {
+    os << (const Operation&) o << " toTrigger " << o.toTrigger;
+    return os;
 }
-
-PhysicalOperation::~PhysicalOperation() {
-
-}
-
@@ -18,18 +18,13 @@
 
 #include "Operation.h"
 
-class PhysicalOperation: public Operation {
-public:
-    bool toTrigger;
-protected:
-    // print has to be a constant method, as the caller is a constant
-    void print(ostream &os) const {
-        Operation::print(os);
-        os << " toTrigger " << toTrigger;
-    }
-public:
-    PhysicalOperation();
-    virtual ~PhysicalOperation();
+struct PhysicalOperation: public Operation {
+    bool toTrigger = false;
 };
 
+ostream& operator<<(ostream& os, const PhysicalOperation& o);
+
+static_assert(is_trivially_copyable<PhysicalOperation>::value,
+        "PhysicalOperation is a record");
+
 #endif /* OBJECTS_PHYSICALOPERATION_H_ */
@@ -0,0 +1,150 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <algorithm>
+#include "ReachabilityIndex.h"
+#include "BitsetReachabilityIndex.h"
+#include "IntervalReachabilityIndex.h"
+
+// largest closure AUTO keeps as bitsets, in bytes
+static const size_t AUTO_BITSET_LIMIT = 64 * 1024 * 1024;
+
+ReachabilityIndex::ReachabilityIndex() {
+    n = 0;
+}
+
+unique_ptr<ReachabilityIndex> ReachabilityIndex::create(Strategy strategy,
+        int n) {
+    if (strategy == AUTO) {
+        size_t closure = (size_t) n * ((n + 63) / 64) * sizeof(uint64_t);
+        strategy = closure <= AUTO_BITSET_LIMIT ? BITSET : INTERVAL;
+    }
+    if (strategy == INTERVAL) {
+        return unique_ptr<ReachabilityIndex>(new IntervalReachabilityIndex());
+    }
+    return unique_ptr<ReachabilityIndex>(new BitsetReachabilityIndex());
+}
+
+bool ReachabilityIndex::parseStrategy(const string& name, Strategy& strategy) {
+    if (name == "auto") {
+        strategy = AUTO;
+    } else if (name == "bitset") {
+        strategy = BITSET;
+    } else if (name == "interval") {
+        strategy = INTERVAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ReachabilityIndex::toCSR(int n, const vector<pair<int, int>>& edges,
+        vector<int>& offsets, vector<int>& targets) {
+    offsets.assign(n + 1, 0);
+    for (auto& e : edges) {
+        offsets[e.first + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+    targets.resize(edges.size());
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (auto& e : edges) {
+        targets[fill[e.first]++] = e.second;
+    }
+}
+
+/*
+ * Iterative Tarjan, so that deep graphs cannot overflow the call stack.
+ * Components are numbered in the order they are completed, i.e., every
+ * component only has edges to components with a smaller number.
+ */
+int ReachabilityIndex::condense(const vector<int>& offsets,
+        const vector<int>& targets) {
+    vector<int> order(n, -1);
+    vector<int> low(n, 0);
+    vector<bool> onStack(n, false);
+    vector<int> st;
+    // <vertex, next edge to visit>
+    vector<pair<int, int>> calls;
+    int visited = 0;
+    int count = 0;
+
+    component.assign(n, -1);
+    for (int s = 0; s < n; s++) {
+        if (order[s] != -1)
+            continue;
+
+        order[s] = low[s] = visited++;
+        st.push_back(s);
+        onStack[s] = true;
+        calls.push_back(make_pair(s, offsets[s]));
+
+        while (!calls.empty()) {
+            int v = calls.back().first;
+            if (calls.back().second < offsets[v + 1]) {
+                int w = targets[calls.back().second++];
+                if (order[w] == -1) {
+                    order[w] = low[w] = visited++;
+                    st.push_back(w);
+                    onStack[w] = true;
+                    calls.push_back(make_pair(w, offsets[w]));
+                } else if (onStack[w]) {
+                    low[v] = min(low[v], order[w]);
+                }
+            } else {
+                if (low[v] == order[v]) {
+                    int w;
+                    do {
+                        w = st.back();
+                        st.pop_back();
+                        onStack[w] = false;
+                        component[w] = count;
+                    } while (w != v);
+                    count++;
+                }
+                calls.pop_back();
+                if (!calls.empty()) {
+                    int u = calls.back().first;
+                    low[u] = min(low[u], low[v]);
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+void ReachabilityIndex::saveComponents(BinaryWriter& out) const {
+    out.put<int32_t>(n);
+    out.putArray(component);
+}
+
+bool ReachabilityIndex::loadComponents(BinaryReader& in) {
+    int32_t size = 0;
+    if (!in.get(size) || !in.getArray(component)) {
+        return false;
+    }
+    n = size;
+    return (int) component.size() == n;
+}
+
+int ReachabilityIndex::size() const {
+    return n;
+}
+
+ReachabilityIndex::~ReachabilityIndex() {
+
+}
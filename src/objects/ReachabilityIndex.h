@@ -0,0 +1,87 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_REACHABILITYINDEX_H_
+#define OBJECTS_REACHABILITYINDEX_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../common/BinaryIO.h"
+#include "../common/MappedFile.h"
+
+using namespace std;
+
+/*
+ * Reachability queries over dense vertex indices [0, n).
+ *
+ * As the former reachability matrix (A + A^2 + ... + A^n), a vertex only
+ * reaches itself if it lies on a cycle. All strategies answer queries on
+ * the condensation of the graph into strongly connected components.
+ */
+class ReachabilityIndex {
+public:
+    enum Strategy {
+        // bitset rows if the closure fits in memory, interval labels otherwise
+        AUTO,
+        // dense transitive closure, O(n^2 / 64) words
+        BITSET,
+        // interval labels with pruned search, O(n + e) words
+        INTERVAL
+    };
+protected:
+    int n;
+    // vertex index -> component index
+    vector<int> component;
+
+    /*
+     * Fill component[] and return the number of components. Components are
+     * numbered so that every edge leads to a component with a smaller number.
+     */
+    int condense(const vector<int>& offsets, const vector<int>& targets);
+    // adjacency lists in CSR layout
+    void toCSR(int n, const vector<pair<int, int>>& edges,
+            vector<int>& offsets, vector<int>& targets);
+    void saveComponents(BinaryWriter& out) const;
+    bool loadComponents(BinaryReader& in);
+public:
+    ReachabilityIndex();
+    ReachabilityIndex(const ReachabilityIndex&) = delete;
+    ReachabilityIndex& operator=(const ReachabilityIndex&) = delete;
+    static unique_ptr<ReachabilityIndex> create(Strategy strategy, int n);
+    // "auto", "bitset" or "interval"
+    static bool parseStrategy(const string& name, Strategy& strategy);
+    virtual void build(int n, const vector<pair<int, int>>& edges) = 0;
+    virtual bool isReachable(int src, int dest) const = 0;
+    virtual size_t memoryUsage() const = 0;
+    // the concrete strategy, never AUTO
+    virtual Strategy getStrategy() const = 0;
+    /*
+     * Precompiled model image. A loaded index may keep pointers into the
+     * image, and then holds on to the mapping.
+     */
+    virtual void save(BinaryWriter& out) const = 0;
+    virtual bool load(BinaryReader& in, shared_ptr<const MappedFile> image) = 0;
+    int size() const;
+    // strongly connected component of a vertex, numbered as by condense
+    int componentOf(int v) const {
+        return component[v];
+    }
+    virtual ~ReachabilityIndex();
+};
+
+#endif /* OBJECTS_REACHABILITYINDEX_H_ */
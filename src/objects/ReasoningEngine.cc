@@ -0,0 +1,91 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include "IncrementalEngine.h"
+#include "ReasoningEngine.h"
+#include "SituationReasoner.h"
+#include "SweepEngine.h"
+
+// constructed on first use, engines register before main
+static vector<ReasoningEngine::Factory>& factories() {
+    static vector<ReasoningEngine::Factory> registered;
+    return registered;
+}
+
+ReasoningEngine::ReasoningEngine() {
+    sr = nullptr;
+}
+
+int* ReasoningEngine::counters() const {
+    return sr->counters.data();
+}
+
+void ReasoningEngine::trigger(int index, simtime_t current) {
+    sr->trigger(index, current);
+}
+
+void ReasoningEngine::mark(int index, simtime_t current) {
+    sr->mark(index, current);
+}
+
+void ReasoningEngine::pushExpiry(int index) {
+    sr->pushExpiry(index);
+}
+
+bool ReasoningEngine::accepts(const SituationGraph& /* sg */) const {
+    return true;
+}
+
+void ReasoningEngine::attach(SituationReasoner& sr) {
+    this->sr = &sr;
+    sg = sr.getModel();
+}
+
+bool ReasoningEngine::parseMode(const string& name, Mode& mode) {
+    if (name == "boolean") {
+        mode = BOOLEAN;
+    } else if (name == "weighted") {
+        mode = WEIGHTED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+unique_ptr<ReasoningEngine> ReasoningEngine::create(const string& name,
+        const SituationGraph& sg, int threads, size_t grain) {
+    if (name == "baseline") {
+        return unique_ptr<ReasoningEngine>(new SweepEngine(BOOLEAN));
+    } else if (name == "incremental") {
+        return unique_ptr<ReasoningEngine>(new IncrementalEngine(BOOLEAN));
+    } else if (name == "parallel") {
+        return unique_ptr<ReasoningEngine>(
+                new SweepEngine(BOOLEAN, threads, grain));
+    } else if (name == "weighted") {
+        return unique_ptr<ReasoningEngine>(new IncrementalEngine(WEIGHTED));
+    } else if (name == "compiled") {
+        for (auto factory : factories()) {
+            unique_ptr<ReasoningEngine> engine(factory());
+            if (engine->accepts(sg)) {
+                return engine;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void ReasoningEngine::add(Factory factory) {
+    factories().push_back(factory);
+}
@@ -0,0 +1,103 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_REASONINGENGINE_H_
+#define OBJECTS_REASONINGENGINE_H_
+
+#include <omnetpp.h>
+#include <memory>
+#include <string>
+#include "SituationGraph.h"
+
+using namespace omnetpp;
+using namespace std;
+
+class SituationReasoner;
+
+/*
+ * Traversal of the upper situations, by which a SituationReasoner
+ * evaluates them in a slice once it has triggered the bottom situations.
+ * The engine of a simulation is picked by name with create():
+ *
+ *   baseline     full sweep of the upper layers with the trigger kernel
+ *   incremental  only the situations the triggered ones may change
+ *   parallel     full sweep, large layers in chunks on a thread pool
+ *   weighted     incremental, with the WEIGHTED trigger condition
+ *   compiled     boolean full sweep generated for the model, see
+ *                CompiledEngine.h
+ *
+ * Engines only differ in cost, each gives the result of the full sweep in
+ * its trigger condition. Compiled engines register themselves at static
+ * initialization with Register_ReasoningEngine.
+ */
+class ReasoningEngine {
+public:
+    /*
+     * Trigger condition of upper situations: BOOLEAN over the evidence
+     * relations, or WEIGHTED, the weights of the satisfied evidences
+     * reaching the situation threshold. Weights are taken as non-negative,
+     * which incremental reasoning relies on.
+     */
+    enum Mode {
+        BOOLEAN, WEIGHTED
+    };
+    typedef ReasoningEngine* (*Factory)();
+private:
+    SituationReasoner* sr;
+protected:
+    shared_ptr<const SituationGraph> sg;
+
+    // counters of the reasoner's situations by dense index
+    int* counters() const;
+    // trigger an upper situation whose condition holds
+    void trigger(int index, simtime_t current);
+    // the state change of trigger, and its expiry, queued in layer order
+    void mark(int index, simtime_t current);
+    void pushExpiry(int index);
+public:
+    ReasoningEngine();
+    // false if the engine cannot reason about the model
+    virtual bool accepts(const SituationGraph& sg) const;
+    /*
+     * Work on the situations of a reasoner, whose model the engine
+     * accepts. Called again whenever the reasoner's model or state is
+     * replaced.
+     */
+    virtual void attach(SituationReasoner& sr);
+    /*
+     * Evaluate the upper situations at current, layers bottom-up and each
+     * in layer order. bottoms are the bottom situations just triggered, as
+     * ascending dense indices.
+     */
+    virtual void sweep(Span<int> bottoms, simtime_t current) = 0;
+    virtual ~ReasoningEngine() {}
+
+    // "boolean" or "weighted"
+    static bool parseMode(const string& name, Mode& mode);
+    /*
+     * The engine of a name for the model, nullptr if the name is unknown or
+     * no compiled engine was generated from the model. threads and grain
+     * are those of the parallel engine, see SweepEngine.
+     */
+    static unique_ptr<ReasoningEngine> create(const string& name,
+            const SituationGraph& sg, int threads = 0, size_t grain = 1024);
+    static void add(Factory factory);
+};
+
+#define Register_ReasoningEngine(CLASS) \
+    static int CLASS##_registered = (ReasoningEngine::add( \
+            []() -> ReasoningEngine* { return new CLASS(); }), 0)
+
+#endif /* OBJECTS_REASONINGENGINE_H_ */
@@ -0,0 +1,86 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_REORDERBUFFER_H_
+#define OBJECTS_REORDERBUFFER_H_
+
+#include <omnetpp.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "OperationalEvent.h"
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Min-heap of events by timestamp, to hand events to the slice of their
+ * timestamp rather than of their arrival. release() pops the events up to
+ * a watermark in timestamp order, events of the same timestamp in arrival
+ * order; push and pop are O(log n).
+ */
+class ReorderBuffer {
+private:
+    struct Entry {
+        int64_t time;
+        uint64_t sequence;
+        OperationalEvent event;
+        bool operator>(const Entry& other) const {
+            return time != other.time ? time > other.time
+                    : sequence > other.sequence;
+        }
+    };
+    vector<Entry> heap;
+    uint64_t sequence;
+public:
+    ReorderBuffer() : sequence(0) {}
+
+    void push(const OperationalEvent& event) {
+        heap.push_back({ event.time, sequence++, event });
+        push_heap(heap.begin(), heap.end(), greater<Entry>());
+    }
+
+    // hand the events with timestamp <= watermark to f, earliest first
+    template <typename F>
+    void release(simtime_t watermark, F f) {
+        int64_t w = watermark.raw();
+        while (!heap.empty() && heap.front().time <= w) {
+            pop_heap(heap.begin(), heap.end(), greater<Entry>());
+            OperationalEvent event = heap.back().event;
+            heap.pop_back();
+            f(event);
+        }
+    }
+
+    // the buffered events in no particular order, e.g. for a snapshot
+    vector<OperationalEvent> events() const {
+        vector<OperationalEvent> all;
+        for (auto& entry : heap) {
+            all.push_back(entry.event);
+        }
+        return all;
+    }
+    void clear() {
+        heap.clear();
+    }
+    size_t size() const {
+        return heap.size();
+    }
+    bool empty() const {
+        return heap.empty();
+    }
+};
+
+#endif /* OBJECTS_REORDERBUFFER_H_ */
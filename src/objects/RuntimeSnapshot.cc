@@ -0,0 +1,97 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <cstdio>
+#include <fstream>
+#include "../common/MappedFile.h"
+#include "RuntimeSnapshot.h"
+
+static const char MAGIC[4] = { 'D', 'T', 'R', 'S' };
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t byteOrder;
+    int32_t scaleExp;
+    // number of nodes and a hash of their IDs in index order
+    int64_t numNodes;
+    uint64_t modelHash;
+    int64_t time;
+};
+
+static uint64_t modelHash(const SituationGraph& model) {
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < model.numNodes(); i++) {
+        uint64_t id = model.idAt(i);
+        for (int b = 0; b < 8; b++) {
+            hash ^= (id >> (b * 8)) & 0xff;
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+bool RuntimeSnapshot::write(const string& file, const SituationGraph& model,
+        simtime_t time, const function<void(BinaryWriter&)>& body) {
+    // write to a temporary file, so that readers never see a partial snapshot
+    string tmpFile = file + ".tmp";
+    ofstream os(tmpFile, ios::binary | ios::trunc);
+    if (!os) {
+        return false;
+    }
+    BinaryWriter out(os);
+
+    SnapshotHeader header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.scaleExp = SimTime::getScaleExp();
+    header.numNodes = model.numNodes();
+    header.modelHash = modelHash(model);
+    header.time = time.raw();
+    out.put(header);
+    body(out);
+
+    os.close();
+    if (!out.good() || os.fail()) {
+        remove(tmpFile.c_str());
+        return false;
+    }
+    remove(file.c_str());
+    return rename(tmpFile.c_str(), file.c_str()) == 0;
+}
+
+bool RuntimeSnapshot::read(const string& file, const SituationGraph& model,
+        simtime_t& time, const function<bool(BinaryReader&)>& body) {
+    MappedFile snapshot;
+    if (!snapshot.open(file)) {
+        return false;
+    }
+    BinaryReader in(snapshot.data(), snapshot.size());
+
+    SnapshotHeader header;
+    if (!in.get(header) || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+            || header.version != VERSION
+            || header.byteOrder != BYTE_ORDER_MARK
+            || header.scaleExp != SimTime::getScaleExp()
+            || header.numNodes != model.numNodes()
+            || header.modelHash != modelHash(model)) {
+        return false;
+    }
+    time = SimTime::fromRaw(header.time);
+    return body(in) && in.good();
+}
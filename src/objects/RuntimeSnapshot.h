@@ -0,0 +1,77 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_RUNTIMESNAPSHOT_H_
+#define OBJECTS_RUNTIMESNAPSHOT_H_
+
+#include <omnetpp.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../common/BinaryIO.h"
+#include "SituationGraph.h"
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Binary snapshot of the runtime state of a module at a simulation time,
+ * to fork runs from a warmed-up state instead of simulating the warmup
+ * again. The module writes the state of its objects through their save
+ * functions; a snapshot is only restored against the same model, by the
+ * IDs of its nodes, and the same simtime resolution.
+ *
+ * Times are restored relative to the snapshot time, so that the restored
+ * run starts at 0 where the snapshot was taken. Messages in flight at
+ * that time are not part of the snapshot.
+ */
+class RuntimeSnapshot {
+public:
+    static const uint32_t VERSION = 2;
+
+    // write the header and the body, return false on an I/O error
+    static bool write(const string& file, const SituationGraph& model,
+            simtime_t time, const function<void(BinaryWriter&)>& body);
+    /*
+     * Read a snapshot of the model written at time, return false if it is
+     * missing, of another model or resolution, or if body fails
+     */
+    static bool read(const string& file, const SituationGraph& model,
+            simtime_t& time, const function<bool(BinaryReader&)>& body);
+
+    // times as raw values, shifted back by the snapshot time when read
+    static void putTimes(BinaryWriter& out, const vector<simtime_t>& times) {
+        vector<int64_t> raw(times.size());
+        for (size_t i = 0; i < times.size(); i++) {
+            raw[i] = times[i].raw();
+        }
+        out.putArray(raw);
+    }
+    static bool getTimes(BinaryReader& in, vector<simtime_t>& times,
+            simtime_t shift) {
+        vector<int64_t> raw;
+        if (!in.getArray(raw)) {
+            return false;
+        }
+        times.resize(raw.size());
+        for (size_t i = 0; i < raw.size(); i++) {
+            times[i] = SimTime::fromRaw(raw[i]) - shift;
+        }
+        return true;
+    }
+};
+
+#endif /* OBJECTS_RUNTIMESNAPSHOT_H_ */
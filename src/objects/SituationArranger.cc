@@ -13,66 +13,429 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include <algorithm>
+#include "../common/Logging.h"
 #include "../common/RandomClass.h"
 #include "../common/Util.h"
 #include "SituationArranger.h"
 
 SituationArranger::SituationArranger() : SituationEvolution() {
+    eventDriven = false;
+    tick = 0.5;
+    part = 0;
 }
 
-vector<PhysicalOperation> SituationArranger::arrange(simtime_t current) {
+void SituationArranger::setModel(shared_ptr<const SituationGraph> sg) {
+    SituationEvolution::setModel(sg);
+    tOpStiuations.clear();
+    partition.reset();
+    buildCauseCounters();
+    buildSchedule();
+    if (eventDriven) {
+        buildCalendar();
+    }
+}
 
-    cout << endl << "current time in Arranger: " << current << endl;
+void SituationArranger::setPartition(shared_ptr<const ModelPartition> partition,
+        int k) {
+    this->partition = partition;
+    part = k;
+    buildCauseCounters();
+    buildSchedule();
+    if (eventDriven) {
+        buildCalendar();
+    }
+}
 
-    vector<PhysicalOperation> operations;
+Span<int> SituationArranger::ownTops() const {
+    return partition ? partition->getTops(part) : sg->getLayerIndices(0);
+}
 
-    /*
-     * Build a list of triggerable top-layer situations
-     */
-    set<long> triggerables;
-    DirectedGraph top = sg.getLayer(0);
-    vector<long> topNodes = top.topo_sort();
-
-    for (auto node : topNodes) {
-        SituationNode s = sg.getNode(node);
-        SituationInstance &si = instanceMap[node];
-        if (s.causes.empty()) {
-            triggerables.insert(si.id);
+Span<int> SituationArranger::ownBottoms() const {
+    return partition ? partition->getBottoms(part)
+            : sg->getLayerIndices(sg->modelHeight() - 1);
+}
+
+void SituationArranger::save(BinaryWriter& out) const {
+    SituationEvolution::save(out);
+    vector<int64_t> ids(tOpStiuations.begin(), tOpStiuations.end());
+    out.putArray(ids);
+}
+
+bool SituationArranger::load(BinaryReader& in, simtime_t shift) {
+    vector<int64_t> ids;
+    if (!SituationEvolution::load(in, shift) || !in.getArray(ids)) {
+        return false;
+    }
+    tOpStiuations.clear();
+    for (auto id : ids) {
+        if (sg->indexOf(id) == -1) {
+            return false;
+        }
+        tOpStiuations.insert(id);
+    }
+    buildCauseCounters();
+    buildSchedule();
+    if (eventDriven) {
+        buildCalendar();
+    }
+    return true;
+}
+
+void SituationArranger::seed(uint64_t seed) {
+    random.Seed(seed);
+}
+
+void SituationArranger::setEventDriven(bool eventDriven, simtime_t tick) {
+    this->eventDriven = eventDriven;
+    this->tick = tick;
+    if (eventDriven && sg) {
+        buildCalendar();
+    }
+}
+
+void SituationArranger::buildCauseCounters() {
+    int n = sg->numNodes();
+    Span<int> tops = ownTops();
+    isTop.assign(n, false);
+    unmetCauses.assign(n, 0);
+    metOrCauses.assign(n, 0);
+    orCauses.assign(n, 0);
+    isReady.assign(n, false);
+    ready.clear();
+
+    // reverse the cause edges of the top situations, self-causes are never
+    // satisfied and need no updates
+    dependentOffsets.assign(n + 1, 0);
+    for (auto ti : tops) {
+        isTop[ti] = true;
+        for (auto ci : sg->getCauses(ti)) {
+            if (ci != ti) {
+                dependentOffsets[ci + 1]++;
+            }
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        dependentOffsets[i + 1] += dependentOffsets[i];
+    }
+    dependents.resize(dependentOffsets[n]);
+    dependentRelations.resize(dependentOffsets[n]);
+    vector<int> cursor(dependentOffsets.begin(), dependentOffsets.end() - 1);
+    for (auto ti : tops) {
+        Span<int> causes = sg->getCauses(ti);
+        Span<char> relations = sg->getCauseRelations(ti);
+        for (size_t k = 0; k < causes.size(); k++) {
+            bool met = counters[causes[k]] > counters[ti];
+            if (relations[k] == SituationRelation::OR) {
+                orCauses[ti]++;
+                metOrCauses[ti] += met;
+            } else if (!met) {
+                unmetCauses[ti]++;
+            }
+            if (causes[k] != ti) {
+                int e = cursor[causes[k]]++;
+                dependents[e] = ti;
+                dependentRelations[e] = relations[k];
+            }
+        }
+        updateReady(ti);
+    }
+}
+
+void SituationArranger::updateReady(int ti) {
+    bool r = unmetCauses[ti] == 0
+            && (orCauses[ti] == 0 || metOrCauses[ti] > 0);
+    if (r != (bool) isReady[ti]) {
+        isReady[ti] = r;
+        if (r) {
+            ready.insert(sg->idAt(ti));
         } else {
-            bool toTrigger = true;
-            for (auto cause : s.causes) {
-                SituationInstance cs = instanceMap[cause];
-                if (cs.counter <= si.counter) {
-                    toTrigger = false;
-                    break;
+            ready.erase(sg->idAt(ti));
+        }
+    }
+}
+
+void SituationArranger::satisfyCause(int ti, char relation, int delta) {
+    if (relation == SituationRelation::OR) {
+        metOrCauses[ti] += delta;
+    } else {
+        unmetCauses[ti] -= delta;
+    }
+    updateReady(ti);
+}
+
+void SituationArranger::raiseCounter(int index) {
+    int counter = ++counters[index];
+
+    // edges from this situation hold once it is just above the top situation
+    for (int e = dependentOffsets[index]; e < dependentOffsets[index + 1]; e++) {
+        int ti = dependents[e];
+        if (counter == counters[ti] + 1) {
+            satisfyCause(ti, dependentRelations[e], 1);
+        }
+    }
+
+    // of the edges into this top situation, those from causes that are no
+    // longer above it fail
+    if (isTop[index]) {
+        Span<int> causes = sg->getCauses(index);
+        Span<char> relations = sg->getCauseRelations(index);
+        for (size_t k = 0; k < causes.size(); k++) {
+            if (causes[k] != index && counters[causes[k]] == counter) {
+                satisfyCause(index, relations[k], -1);
+            }
+        }
+    }
+}
+
+simtime_t SituationArranger::ceilTick(simtime_t time) const {
+    int64_t w = tick.raw();
+    return SimTime::fromRaw((time.raw() + w - 1) / w * w);
+}
+
+bool SituationArranger::eligible(int ti) const {
+    return states[ti] == SituationInstance::UNTRIGGERED && isReady[ti];
+}
+
+bool SituationArranger::allEmitted(int ti) const {
+    for (auto bi : sg->getOperationalSitutionsAt(ti)) {
+        if (counters[bi] <= counters[ti]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Polled, the top situation triggers on each eligible tick with odds 0.3,
+ * so the tick it triggers on is drawn once, geometrically, from the first
+ * eligible one.
+ */
+void SituationArranger::scheduleTrigger(int ti, simtime_t earliest) {
+    simtime_t first = max(ceilTick(nextStarts[ti]), earliest);
+    int failed = 0;
+    while (random.NextDecimal() <= 0.7) {
+        failed++;
+    }
+    calendar.push(first + tick * failed, { ti, TOP_TRIGGER });
+    scheduled[ti] = true;
+}
+
+void SituationArranger::scheduleReset(int ti, simtime_t earliest) {
+    simtime_t end = ceilTick(nextStarts[ti] + durations[ti]);
+    calendar.push(max(end, earliest), { ti, TOP_RESET });
+    scheduled[ti] = true;
+}
+
+void SituationArranger::buildCalendar() {
+    int n = sg->numNodes();
+    scheduled.assign(n, false);
+    owners.assign(n, vector<int>());
+    markedAt.assign(n, -1);
+
+    Span<int> tops = ownTops();
+    Span<int> bottoms = ownBottoms();
+    for (auto ti : tops) {
+        for (auto bi : sg->getOperationalSitutionsAt(ti)) {
+            owners[bi].push_back(ti);
+        }
+    }
+
+    // one year covers the longest cycle
+    simtime_t horizon = tick;
+    for (auto bi : bottoms) {
+        horizon = max(horizon, cycles[bi]);
+    }
+    size_t days = horizon.raw() / tick.raw() + 1;
+    calendar.reset(min(max(days, (size_t) 16), (size_t) 4096), tick);
+
+    for (auto bi : bottoms) {
+        int64_t c = cycles[bi].raw();
+        if (c > 0) {
+            // first cycle multiple at or after the first tick
+            int64_t first = (tick.raw() + c - 1) / c * c;
+            calendar.push(SimTime::fromRaw(first), { bi, BOTTOM_DUE });
+        }
+    }
+    // top situations restored triggered wait for their reset
+    for (auto ti : tops) {
+        if (states[ti] == SituationInstance::TRIGGERED) {
+            if (allEmitted(ti)) {
+                scheduleReset(ti, tick);
+            }
+        } else if (eligible(ti)) {
+            scheduleTrigger(ti, tick);
+        }
+    }
+}
+
+void SituationArranger::buildSchedule() {
+    int n = sg->numNodes();
+    Span<int> bottoms = ownBottoms();
+    if (!schedule.build(bottoms, cycles)) {
+        LOG_INFO << "cycles of the operational situations not tabulated"
+                << endl;
+    }
+    isOwnBottom.assign(n, false);
+    isListed.assign(n, false);
+    triggeredBottoms.clear();
+    for (auto bi : bottoms) {
+        isOwnBottom[bi] = true;
+    }
+    // e.g. restored from a snapshot
+    for (auto bi : bottoms) {
+        if (states[bi] == SituationInstance::TRIGGERED) {
+            markTriggered(bi);
+        }
+    }
+}
+
+void SituationArranger::markTriggered(int bi) {
+    states[bi] = SituationInstance::TRIGGERED;
+    if (isOwnBottom[bi] && !isListed[bi]) {
+        isListed[bi] = true;
+        triggeredBottoms.push_back(bi);
+    }
+}
+
+bool SituationArranger::nextDue(simtime_t& time) {
+    if (calendar.empty()) {
+        return false;
+    }
+    time = calendar.peekTime();
+    return true;
+}
+
+vector<PhysicalOperation> SituationArranger::arrangeDue(simtime_t current) {
+
+    LOG_TRACE << endl << "current time in Arranger: " << current << endl;
+
+    vector<PhysicalOperation> operations;
+
+    due.clear();
+    while (!calendar.empty() && calendar.peekTime() <= current) {
+        calendar.popAll(calendar.peekTime(), due);
+    }
+
+    // top situations by ID before operational situations in layer order
+    stable_sort(due.begin(), due.end(), [this](const Due& a, const Due& b) {
+        if ((a.type == BOTTOM_DUE) != (b.type == BOTTOM_DUE)) {
+            return b.type == BOTTOM_DUE;
+        }
+        if (a.type == BOTTOM_DUE) {
+            return sg->getLayerPosition(a.index) < sg->getLayerPosition(b.index);
+        }
+        return sg->idAt(a.index) < sg->idAt(b.index);
+    });
+
+    for (auto& entry : due) {
+        int index = entry.index;
+        switch (entry.type) {
+        case TOP_TRIGGER:
+            LOG_DEBUG << "trigger situation " << sg->idAt(index) << endl;
+
+            scheduled[index] = false;
+            states[index] = SituationInstance::TRIGGERED;
+            for (auto bi : sg->getOperationalSitutionsAt(index)) {
+                markedAt[bi] = current;
+                tOpStiuations.insert(sg->idAt(bi));
+            }
+            if (allEmitted(index)) {
+                scheduleReset(index, current + tick);
+            }
+            break;
+        case TOP_RESET:
+            LOG_DEBUG << "reset situation " << sg->idAt(index) << endl;
+
+            scheduled[index] = false;
+            states[index] = SituationInstance::UNTRIGGERED;
+            raiseCounter(index);
+            nextStarts[index] = current + cycles[index];
+            for (auto bi : sg->getOperationalSitutionsAt(index)) {
+                tOpStiuations.erase(sg->idAt(bi));
+            }
+
+            // the reset may have made this and other top situations eligible
+            if (eligible(index)) {
+                scheduleTrigger(index, current + tick);
+            }
+            for (int e = dependentOffsets[index];
+                    e < dependentOffsets[index + 1]; e++) {
+                int ti = dependents[e];
+                if (!scheduled[ti] && eligible(ti)) {
+                    scheduleTrigger(ti, current + tick);
                 }
             }
-            if (toTrigger) {
-                triggerables.insert(si.id);
+            break;
+        case BOTTOM_DUE: {
+            PhysicalOperation s;
+            s.id = sg->idAt(index);
+            s.setTimestamp(current);
+            s.toTrigger = false;
+            if (tOpStiuations.count(s.id)) {
+                bool wanted = markedAt[index] == current;
+                for (auto ti : owners[index]) {
+                    wanted = wanted || (states[ti] == SituationInstance::TRIGGERED
+                            && counters[index] <= counters[ti]);
+                }
+                if (wanted) {
+                    raiseCounter(index);
+                    s.toTrigger = true;
+                    for (auto ti : owners[index]) {
+                        if (states[ti] == SituationInstance::TRIGGERED
+                                && !scheduled[ti] && allEmitted(ti)) {
+                            scheduleReset(ti, current + tick);
+                        }
+                    }
+                }
             }
+            operations.push_back(s);
+            calendar.push(current + cycles[index], { index, BOTTOM_DUE });
+            break;
         }
+        }
+    }
+
+    return operations;
+}
+
+vector<PhysicalOperation> SituationArranger::arrange(simtime_t current) {
+    if (eventDriven) {
+        return arrangeDue(current);
+    }
+
+    LOG_TRACE << endl << "current time in Arranger: " << current << endl;
+
+    vector<PhysicalOperation> operations;
+    operations.reserve(schedule.peakDue());
+
+    /*
+     * Take the triggerable top-layer situations as of the start of the
+     * tick, resets below only affect the next one
+     */
+    polled.clear();
+    for (auto triggerable : ready) {
+        polled.push_back(sg->indexOf(triggerable));
     }
 
     /*
      * build a list of triggerable operational situations
      */
-    for (auto triggerable : triggerables) {
+    for (auto ti : polled) {
 
         // top instance
-        SituationInstance &ti = instanceMap[triggerable];
+        long triggerable = sg->idAt(ti);
 
-        if (ti.state == SituationInstance::UNTRIGGERED) {
-            if (ti.next_start <= current && Random.NextDecimal() > 0.7) {
+        if (states[ti] == SituationInstance::UNTRIGGERED) {
+            if (nextStarts[ti] <= current && random.NextDecimal() > 0.7) {
 
-                cout << "trigger situation " << ti.id << endl;
+                LOG_DEBUG << "trigger situation " << triggerable << endl;
 
-                ti.state = SituationInstance::TRIGGERED;
-                vector<long> tBottoms = sg.getOperationalSitutions(triggerable);
-                for (auto tBottom : tBottoms) {
+                states[ti] = SituationInstance::TRIGGERED;
+                for (auto bi : sg->getOperationalSitutionsAt(ti)) {
                     // bottom instance
-                    SituationInstance &bi = instanceMap[tBottom];
-                    bi.state = SituationInstance::TRIGGERED;
-                    tOpStiuations.insert(tBottom);
+                    markTriggered(bi);
+                    tOpStiuations.insert(sg->idAt(bi));
                 }
             }
         } else {
@@ -82,37 +445,34 @@ vector<PhysicalOperation> SituationArranger::arrange(simtime_t current) {
              * to untriggered.
              */
             bool allTriggered = true;
-            vector<long> tBottoms = sg.getOperationalSitutions(triggerable);
-            for (auto tBottom : tBottoms) {
+            Span<int> tBottoms = sg->getOperationalSitutionsAt(ti);
+            for (auto bi : tBottoms) {
                 // bottom instance
-                SituationInstance &bi = instanceMap[tBottom];
-                if (bi.state == SituationInstance::TRIGGERED
-                        || bi.counter <= ti.counter) {
+                if (states[bi] == SituationInstance::TRIGGERED
+                        || counters[bi] <= counters[ti]) {
                     allTriggered = false;
                     break;
                 }
             }
 
-            if (allTriggered && ti.next_start + ti.duration <= current) {
+            if (allTriggered && nextStarts[ti] + durations[ti] <= current) {
 
-                cout << "reset situation " << ti.id << endl;
+                LOG_DEBUG << "reset situation " << triggerable << endl;
 
-                ti.state = SituationInstance::UNTRIGGERED;
-                ti.counter++;
-                ti.next_start = current + ti.cycle;
+                states[ti] = SituationInstance::UNTRIGGERED;
+                raiseCounter(ti);
+                nextStarts[ti] = current + cycles[ti];
 
-                for (auto tBottom : tBottoms) {
-                    tOpStiuations.erase(tOpStiuations.find(tBottom));
+                for (auto bi : tBottoms) {
+                    tOpStiuations.erase(sg->idAt(bi));
                 }
             } else {
-                vector<long> tBottoms = sg.getOperationalSitutions(triggerable);
-                for (auto tBottom : tBottoms) {
+                for (auto bi : tBottoms) {
                     // bottom instance
-                    SituationInstance &bi = instanceMap[tBottom];
-                    if (bi.state == SituationInstance::UNTRIGGERED
-                            && bi.counter <= ti.counter) {
-                        bi.state = SituationInstance::TRIGGERED;
-                        tOpStiuations.insert(tBottom);
+                    if (states[bi] == SituationInstance::UNTRIGGERED
+                            && counters[bi] <= counters[ti]) {
+                        markTriggered(bi);
+                        tOpStiuations.insert(sg->idAt(bi));
                     }
                 }
             }
@@ -122,35 +482,57 @@ vector<PhysicalOperation> SituationArranger::arrange(simtime_t current) {
 //    cout << "print triggerable operational stiuations: ";
 //    util::printSet(tOpStiuations);
 
-    vector<long> bottoms = sg.getAllOperationalSitutions();
-
-    for (auto bottom : bottoms) {
-        SituationInstance &bi = instanceMap[bottom];
-
-        // cycle match check
-        simtime_t value = fmod(current, bi.cycle);
-        if (value == 0) {
-            PhysicalOperation s;
-            s.id = bi.id;
-            s.timestamp = current;
-            s.toTrigger = false;
-            auto it = tOpStiuations.find(bi.id);
-            if (it != tOpStiuations.end()) {
-                if (bi.state == SituationInstance::TRIGGERED) {
-                    bi.counter++;
-                    bi.state = SituationInstance::UNTRIGGERED;
-                    s.toTrigger = true;
-                }
+    if (schedule.isBuilt()) {
+        for (auto bi : schedule.dueAt(current)) {
+            arrangeBottom(bi, current, operations);
+        }
+    } else {
+        for (auto bi : ownBottoms()) {
+            // cycle match check
+            simtime_t value = fmod(current, cycles[bi]);
+            if (value == 0) {
+                arrangeBottom(bi, current, operations);
+            } else {
+                states[bi] = SituationInstance::UNTRIGGERED;
             }
-            operations.push_back(s);
+        }
+    }
+
+    // operational situations not due at this tick lose their trigger
+    size_t kept = 0;
+    for (auto bi : triggeredBottoms) {
+        int64_t c = cycles[bi].raw();
+        if (c <= 0 || current.raw() % c != 0) {
+            states[bi] = SituationInstance::UNTRIGGERED;
+        }
+        if (states[bi] == SituationInstance::TRIGGERED) {
+            triggeredBottoms[kept++] = bi;
         } else {
-            bi.state = SituationInstance::UNTRIGGERED;
+            isListed[bi] = false;
         }
     }
+    triggeredBottoms.resize(kept);
 
     return operations;
 }
 
+void SituationArranger::arrangeBottom(int bi, simtime_t current,
+        vector<PhysicalOperation>& operations) {
+    PhysicalOperation s;
+    s.id = sg->idAt(bi);
+    s.setTimestamp(current);
+    s.toTrigger = false;
+    auto it = tOpStiuations.find(s.id);
+    if (it != tOpStiuations.end()) {
+        if (states[bi] == SituationInstance::TRIGGERED) {
+            raiseCounter(bi);
+            states[bi] = SituationInstance::UNTRIGGERED;
+            s.toTrigger = true;
+        }
+    }
+    operations.push_back(s);
+}
+
 SituationArranger::~SituationArranger() {
 
 }
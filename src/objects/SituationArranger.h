@@ -20,21 +20,133 @@
 #include <map>
 #include <set>
 #include <vector>
+#include "../common/CalendarQueue.h"
+#include "../common/RandomClass.h"
+#include "CycleSchedule.h"
 #include "SituationInstance.h"
 #include "PhysicalOperation.h"
 #include "SituationGraph.h"
+#include "ModelPartition.h"
 #include "SituationEvolution.h"
 
 using namespace omnetpp;
 using namespace std;
 
+/*
+ * Generates the physical operations of the operational situations.
+ *
+ * By default arrange is polled every tick and looks up the operational
+ * situations due in a table over the hyperperiod of their cycles, built
+ * when the model is set (see CycleSchedule). In event-driven mode the
+ * arranger keeps the next due time of every operational situation, and
+ * every trigger and reset of a top situation, in a calendar queue; arrange
+ * then only visits what is due and nextDue tells the caller when to come
+ * back. Top situations trigger and reset on the tick grid with the same
+ * odds as when polled.
+ *
+ * In both modes the horizontal causes of the top situations are tracked
+ * incrementally: each top situation counts its unsatisfied AND and SOLE
+ * causes and its satisfied OR causes, updated whenever a counter the
+ * cause edge depends on is raised, and the top situations whose causes
+ * hold are kept in a ready set.
+ *
+ * With a partition set, only the top and operational situations of that
+ * partition are arranged, see ModelPartition.
+ */
 class SituationArranger: public SituationEvolution {
 private:
+    enum DueType {
+        BOTTOM_DUE, TOP_TRIGGER, TOP_RESET
+    };
+    struct Due {
+        int index;
+        DueType type;
+    };
+
     // triggerable operational situations
     set<long> tOpStiuations;
+    // trigger draws of this arranger only
+    RandomClass random;
+    // situations arranged, all unless partitioned
+    shared_ptr<const ModelPartition> partition;
+    int part;
+
+    bool eventDriven;
+    simtime_t tick;
+    CalendarQueue<Due> calendar;
+    // entries due at the current time
+    vector<Due> due;
+    // top situation has a trigger or reset in the calendar
+    vector<char> scheduled;
+    // top situations over each operational situation
+    vector<vector<int>> owners;
+    // cause edges into top situations, grouped by the cause
+    vector<int> dependentOffsets;
+    vector<int> dependents;
+    vector<char> dependentRelations;
+    vector<char> isTop;
+    // unsatisfied AND and SOLE causes of each top situation
+    vector<int> unmetCauses;
+    // satisfied and all OR causes of each top situation
+    vector<int> metOrCauses;
+    vector<int> orCauses;
+    // top situations whose causes hold, by ID
+    set<long> ready;
+    vector<char> isReady;
+    // top situations polled in the current tick
+    vector<int> polled;
+    // time each operational situation was last marked by a trigger
+    vector<simtime_t> markedAt;
+    // due table of the own operational situations, when polled
+    CycleSchedule schedule;
+    vector<char> isOwnBottom;
+    // own operational situations left triggered by polling
+    vector<int> triggeredBottoms;
+    vector<char> isListed;
+
+    Span<int> ownTops() const;
+    Span<int> ownBottoms() const;
+    void buildCauseCounters();
+    void updateReady(int ti);
+    void satisfyCause(int ti, char relation, int delta);
+    // increment a counter, updating the cause edges depending on it
+    void raiseCounter(int index);
+    vector<PhysicalOperation> arrangeDue(simtime_t current);
+    void buildCalendar();
+    void buildSchedule();
+    void markTriggered(int bi);
+    void arrangeBottom(int bi, simtime_t current,
+            vector<PhysicalOperation>& operations);
+    simtime_t ceilTick(simtime_t time) const;
+    bool eligible(int ti) const;
+    bool allEmitted(int ti) const;
+    void scheduleTrigger(int ti, simtime_t earliest);
+    void scheduleReset(int ti, simtime_t earliest);
 public:
     SituationArranger();
+    void setModel(shared_ptr<const SituationGraph> sg) override;
+    // the trigger draws are not part of the snapshot
+    void save(BinaryWriter& out) const override;
+    bool load(BinaryReader& in, simtime_t shift) override;
+    // arrange partition k of the model only, or all with nullptr
+    void setPartition(shared_ptr<const ModelPartition> partition, int k);
+    // restart the trigger draws, e.g. from the owning module's RNG
+    void seed(uint64_t seed);
+    /*
+     * Switch to event-driven arrangement on a grid of the given tick,
+     * starting from the current instance state at time 0
+     */
+    void setEventDriven(bool eventDriven, simtime_t tick);
     vector<PhysicalOperation> arrange(simtime_t current);
+    /*
+     * Earliest time with something to arrange in event-driven mode, false
+     * if nothing will ever be due
+     */
+    bool nextDue(simtime_t& time);
+    // due table of the polled operational situations, if not too large
+    const CycleSchedule& getSchedule() const {
+        return schedule;
+    }
     virtual ~SituationArranger();
 };
 
@@ -13,6 +13,8 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include "ModelRegistry.h"
+#include "RuntimeSnapshot.h"
 #include "SituationEvolution.h"
 
 SituationEvolution::SituationEvolution() {
@@ -23,26 +25,96 @@ SituationEvolution::~SituationEvolution() {
     // TODO Auto-generated destructor stub
 }
 
-void SituationEvolution::initModel(const char *model_path) {
-    sg.loadModel(model_path, this);
+void SituationEvolution::initModel(const char *model_path,
+        ReachabilityIndex::Strategy strategy, bool useImage) {
+    setModel(ModelRegistry::get(model_path, strategy, useImage));
+}
+
+void SituationEvolution::setModel(shared_ptr<const SituationGraph> sg) {
+    this->sg = sg;
+    int size = sg->numNodes();
+    counters.assign(size, 0);
+    states.assign(size, SituationInstance::UNTRIGGERED);
+    durations.assign(size, 0);
+    cycles.assign(size, 0);
+    nextStarts.assign(size, 0);
+    for (int i = 0; i < sg->numNodes(); i++) {
+        const SituationNode& node = sg->getNodeAt(i);
+        addInstance(node.id, SimTime(node.duration), SimTime(node.cycle));
+    }
+}
+
+int SituationEvolution::indexOf(long id) const {
+    int index = sg->indexOf(id);
+    if (index == -1) {
+        throw cRuntimeError("Situation %ld is not in the model", id);
+    }
+    return index;
 }
 
 void SituationEvolution::addInstance(long id, simtime_t duration,
         simtime_t cycle) {
-    SituationInstance si(id, duration, cycle);
-    instanceMap[si.id] = si;
+    int index = indexOf(id);
+    counters[index] = 0;
+    states[index] = SituationInstance::UNTRIGGERED;
+    durations[index] = duration;
+    cycles[index] = cycle;
+    nextStarts[index] = cycle;
+}
+
+void SituationEvolution::save(BinaryWriter& out) const {
+    out.putArray(counters);
+    out.putArray(states);
+    RuntimeSnapshot::putTimes(out, durations);
+    RuntimeSnapshot::putTimes(out, cycles);
+    RuntimeSnapshot::putTimes(out, nextStarts);
+}
+
+bool SituationEvolution::load(BinaryReader& in, simtime_t shift) {
+    size_t n = sg->numNodes();
+    vector<int> c;
+    vector<SituationInstance::State> s;
+    vector<simtime_t> d, y, ns;
+    // durations and cycles are lengths, not points in time
+    if (!in.getArray(c) || !in.getArray(s) || !RuntimeSnapshot::getTimes(in, d, 0)
+            || !RuntimeSnapshot::getTimes(in, y, 0)
+            || !RuntimeSnapshot::getTimes(in, ns, shift) || c.size() != n
+            || s.size() != n || d.size() != n || y.size() != n
+            || ns.size() != n) {
+        return false;
+    }
+    for (auto state : s) {
+        if (state != SituationInstance::UNTRIGGERED
+                && state != SituationInstance::TRIGGERED) {
+            return false;
+        }
+    }
+    counters.swap(c);
+    states.swap(s);
+    durations.swap(d);
+    cycles.swap(y);
+    nextStarts.swap(ns);
+    return true;
+}
+
+SituationInstance SituationEvolution::getInstance(long id) const {
+    return getInstanceAt(indexOf(id));
 }
 
-SituationInstance& SituationEvolution::getInstance(long id){
-    return instanceMap[id];
+SituationInstance SituationEvolution::getInstanceAt(int index) const {
+    SituationInstance si(sg->idAt(index), durations[index], cycles[index]);
+    si.counter = counters[index];
+    si.state = states[index];
+    si.next_start = nextStarts[index];
+    return si;
 }
 
-SituationGraph& SituationEvolution::getModel(){
+shared_ptr<const SituationGraph> SituationEvolution::getModel() const {
     return sg;
 }
 
 void SituationEvolution::print() {
-    for (auto m : instanceMap) {
-        cout << m.second;
+    for (int i = 0; i < sg->numNodes(); i++) {
+        cout << getInstanceAt(i);
     }
 }
@@ -18,8 +18,11 @@
 
 #include <omnetpp.h>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <set>
 #include <vector>
+#include "../common/BinaryIO.h"
 #include "SituationInstance.h"
 #include "PhysicalOperation.h"
 #include "SituationGraph.h"
@@ -27,17 +30,50 @@
 using namespace omnetpp;
 using namespace std;
 
+// situation IDs in ascending order, in the memory of the caller's choice
+typedef pmr::set<long> SituationSet;
+
+/*
+ * Runtime state of a situation model. Instance fields are kept in
+ * structure-of-arrays layout by dense node index, so that the per-slice
+ * walks over the model touch contiguous memory and never allocate.
+ */
 class SituationEvolution {
 protected:
-    SituationGraph sg;
-    map<int, SituationInstance> instanceMap;
+    shared_ptr<const SituationGraph> sg;
+    // instance state by dense index
+    vector<int> counters;
+    vector<SituationInstance::State> states;
+    vector<simtime_t> durations;
+    vector<simtime_t> cycles;
+    // see SituationInstance::next_start
+    vector<simtime_t> nextStarts;
+
+    // dense index of a situation, throw if not in the model
+    int indexOf(long id) const;
 public:
     SituationEvolution();
-    void initModel(const char* model_path);
+    // load a model through the registry and create its instances
+    void initModel(const char* model_path,
+            ReachabilityIndex::Strategy strategy = ReachabilityIndex::AUTO,
+            bool useImage = true);
+    virtual void setModel(shared_ptr<const SituationGraph> sg);
     // return a list of operations as operational situations
     void addInstance(long id, simtime_t duration = 0, simtime_t cycle = 0);
-    SituationInstance& getInstance(long id);
-    SituationGraph& getModel();
+    // snapshot of one instance
+    SituationInstance getInstance(long id) const;
+    SituationInstance getInstanceAt(int index) const;
+    int getCounterAt(int index) const {
+        return counters[index];
+    }
+    shared_ptr<const SituationGraph> getModel() const;
+    /*
+     * Write the instance state for a RuntimeSnapshot, and restore it with
+     * its times moved back by shift. load returns false on a malformed or
+     * mismatching snapshot.
+     */
+    virtual void save(BinaryWriter& out) const;
+    virtual bool load(BinaryReader& in, simtime_t shift);
     void print();
     virtual ~SituationEvolution();
 };
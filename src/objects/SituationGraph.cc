@@ -14,284 +14,388 @@
 // 
 
 #include <omnetpp.h>
+#include <algorithm>
+#include <iterator>
 #include <stack>
-#include <boost/json.hpp>
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
 #include "boost/tuple/tuple.hpp"
 #include "boost/tuple/tuple_comparison.hpp"
 #include "boost/tuple/tuple_io.hpp"
-#include "SituationEvolution.h"
+#include "ModelReader.h"
 #include "SituationGraph.h"
 
 using namespace omnetpp;
-namespace pt = boost::property_tree;
 
 SituationGraph::SituationGraph() {
     // TODO Auto-generated constructor stub
 }
 
-vector<long> SituationGraph::getAllOperationalSitutions() {
+const vector<long>& SituationGraph::getAllOperationalSitutions() const {
+    return layerOrders.back();
+}
+
+vector<long> SituationGraph::getOperationalSitutions(long topNodeId) const {
     vector<long> operational_situations;
-    DirectedGraph& bottom = layers[layers.size() - 1];
-    vector<long> bottom_nodes = bottom.topo_sort();
-    for (auto node : bottom_nodes) {
-        SituationNode& operational_situation = situationMap[node];
-        operational_situations.push_back(operational_situation.id);
+
+    int top = indexOf(topNodeId);
+    if (top == -1) {
+        return operational_situations;
     }
+    for (auto index : getOperationalSitutionsAt(top)) {
+        operational_situations.push_back(nodes[index].id);
+    }
+
     return operational_situations;
 }
 
-vector<long> SituationGraph::getOperationalSitutions(long topNodeId) {
-    vector<long> operational_situations;
+bool SituationGraph::isReachable(long src, long dest) const {
+    if (!ri) {
+        return false;
+    }
+    int i = indexOf(src);
+    int j = indexOf(dest);
+    if (i == -1 || j == -1) {
+        return false;
+    }
+    return ri->isReachable(i, j);
+}
 
-    SituationNode& topNode = situationMap[topNodeId];
-    stack<SituationNode> toChecks;
-    toChecks.push(topNode);
-    while (!toChecks.empty()) {
-        SituationNode toCheck = toChecks.top();
-        toChecks.pop();
-        if (!toCheck.evidences.empty()) {
-            for (auto evidenceId : toCheck.evidences) {
-                SituationNode evidence = situationMap[evidenceId];
-                toChecks.push(evidence);
+void SituationGraph::buildRelationArrays() {
+    int size = nodes.size();
+    causeOffsets.assign(size + 1, 0);
+    evidenceOffsets.assign(size + 1, 0);
+    causeIndices.clear();
+    evidenceIndices.clear();
+    for (int i = 0; i < size; i++) {
+        for (auto cause : nodes[i].causes) {
+            int c = indexOf(cause);
+            if (c != -1) {
+                causeIndices.push_back(c);
+            }
+        }
+        causeOffsets[i + 1] = causeIndices.size();
+        for (auto evidence : nodes[i].evidences) {
+            int e = indexOf(evidence);
+            if (e != -1) {
+                evidenceIndices.push_back(e);
             }
-        } else {
-            operational_situations.push_back(toCheck.id);
         }
+        evidenceOffsets[i + 1] = evidenceIndices.size();
     }
-
-    return operational_situations;
 }
 
-bool SituationGraph::isReachable(long src, long dest){
-    int i = situationMap[src].index;
-    int j = situationMap[dest].index;
-    return ri->at(i)[j];
-}
+void SituationGraph::buildOperationalArrays() {
+    int size = nodes.size();
+    vector<vector<int>> operational(size);
+
+    /*
+     * Situations without evidences are operational. Other situations merge
+     * the sets of their evidences, which are completed first in post-order.
+     */
+    // 0 - unvisited, 1 - on the DFS stack, 2 - done
+    vector<char> visit(size, 0);
+    bool cyclic = false;
+    stack<pair<int, int>> toChecks;
+    for (int root = 0; root < size && !cyclic; root++) {
+        if (visit[root]) {
+            continue;
+        }
+        toChecks.push(make_pair(root, 0));
+        visit[root] = 1;
+        while (!toChecks.empty() && !cyclic) {
+            int v = toChecks.top().first;
+            int& next = toChecks.top().second;
+            Span<int> evidences = getEvidences(v);
+            if (next < (int) evidences.size()) {
+                int w = evidences[next++];
+                if (visit[w] == 0) {
+                    visit[w] = 1;
+                    toChecks.push(make_pair(w, 0));
+                } else if (visit[w] == 1) {
+                    cyclic = true;
+                }
+                continue;
+            }
+            toChecks.pop();
+            visit[v] = 2;
+            vector<int>& merged = operational[v];
+            if (evidences.empty()) {
+                merged.push_back(v);
+            }
+            for (auto evidence : evidences) {
+                vector<int> result;
+                const vector<int>& other = operational[evidence];
+                set_union(merged.begin(), merged.end(), other.begin(),
+                        other.end(), back_inserter(result));
+                merged.swap(result);
+            }
+        }
+    }
 
-/*
- * For square matrix only
- */
-vector<vector<bool>> boolMatrixPower(vector<vector<bool>> &mat, int n) {
-    vector<vector<bool>> mat_n = mat;
-
-    for (int pow = 0; pow < n - 1; pow++) {
-        vector<vector<bool>> temp = mat_n;
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                bool value = false;
-                for (int m = 0; m < n; m++) {
-                    value = value || (temp[i][m] && mat[m][j]);
-                    if (value)
-                        // early out
-                        break;
+    if (cyclic) {
+        // evidence cycles, search from every situation instead
+        vector<int> stamps(size, -1);
+        for (int v = 0; v < size; v++) {
+            vector<int>& found = operational[v];
+            found.clear();
+            stack<int> pending;
+            pending.push(v);
+            stamps[v] = v;
+            while (!pending.empty()) {
+                int u = pending.top();
+                pending.pop();
+                Span<int> evidences = getEvidences(u);
+                if (evidences.empty()) {
+                    found.push_back(u);
+                }
+                for (auto evidence : evidences) {
+                    if (stamps[evidence] != v) {
+                        stamps[evidence] = v;
+                        pending.push(evidence);
+                    }
                 }
-                mat_n[i][j] = value;
             }
+            sort(found.begin(), found.end());
         }
     }
 
-    return mat_n;
+    operationalOffsets.assign(size + 1, 0);
+    operationalIndices.clear();
+    for (int v = 0; v < size; v++) {
+        operationalIndices.insert(operationalIndices.end(),
+                operational[v].begin(), operational[v].end());
+        operationalOffsets[v + 1] = operationalIndices.size();
+    }
 }
 
-/*
- * For square matrix only
- */
-void boolMatrixAdd(vector<vector<bool>>* result, vector<vector<bool>> &mat1,
-        vector<vector<bool>> &mat2) {
-    int n = mat1.size();
+void SituationGraph::buildSupportArrays() {
+    int size = nodes.size();
+    supportOffsets.assign(size + 1, 0);
+    for (int e : evidenceIndices) {
+        supportOffsets[e + 1]++;
+    }
+    for (int i = 0; i < size; i++) {
+        supportOffsets[i + 1] += supportOffsets[i];
+    }
+    supportIndices.resize(evidenceIndices.size());
+    vector<int> cursor(supportOffsets.begin(), supportOffsets.end() - 1);
+    for (int i = 0; i < size; i++) {
+        for (auto e : getEvidences(i)) {
+            supportIndices[cursor[e]++] = i;
+        }
+    }
 
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            result->at(i)[j] = mat1[i][j] || mat2[i][j];
+    nodeLayers.assign(size, -1);
+    nodePositions.assign(size, -1);
+    for (size_t l = 0; l < layerIndices.size(); l++) {
+        for (size_t p = 0; p < layerIndices[l].size(); p++) {
+            nodeLayers[layerIndices[l][p]] = l;
+            nodePositions[layerIndices[l][p]] = p;
         }
     }
 }
 
-void SituationGraph::buildReachabilityMatrix(set<long>& vertices, set<edge_id>& edges) {
-    /*
-     * initialize reachability matrix
-     */
-    int size = vertices.size();
-    ri = new vector<vector<bool>>(size, vector<bool>(size, false));
-
-    /*
-     * build adjacency matrix
-     */
-    vector<vector<bool>> adjMatrix(size, vector<bool>(size, false));
-    for (auto src : vertices) {
-        for (auto dest : vertices) {
-            if (src != dest) {
-                edge_id eid(src, dest);
-                if (edges.count(eid)) {
-                    int i = situationMap[src].index;
-                    int j = situationMap[dest].index;
-                    adjMatrix[i][j] = true;
+void SituationGraph::buildLevelArrays() {
+    vector<int> levels(nodes.size(), 0);
+    levelNodes.clear();
+    levelOffsets.assign(1, 0);
+    layerLevels.assign(1, 0);
+    for (size_t l = 0; l < layerIndices.size(); l++) {
+        int height = 0;
+        for (auto index : layerIndices[l]) {
+            int level = 0;
+            int position = nodePositions[index];
+            for (auto e : getEvidences(index)) {
+                if (nodeLayers[e] == (int) l && nodePositions[e] < position) {
+                    level = max(level, levels[e] + 1);
+                }
+            }
+            for (auto s : getSupports(index)) {
+                if (nodeLayers[s] == (int) l && nodePositions[s] < position) {
+                    level = max(level, levels[s] + 1);
                 }
             }
+            levels[index] = level;
+            height = max(height, level + 1);
+        }
+
+        // bucket the layer by level, keeping the layer order in each
+        vector<int> counts(height + 1, 0);
+        for (auto index : layerIndices[l]) {
+            counts[levels[index] + 1]++;
+        }
+        for (int k = 0; k < height; k++) {
+            counts[k + 1] += counts[k];
+        }
+        size_t base = levelNodes.size();
+        levelNodes.resize(base + layerIndices[l].size());
+        vector<int> cursor(counts.begin(), counts.end() - 1);
+        for (auto index : layerIndices[l]) {
+            levelNodes[base + cursor[levels[index]]++] = index;
         }
+        for (int k = 1; k <= height; k++) {
+            levelOffsets.push_back(base + counts[k]);
+        }
+        layerLevels.push_back(levelOffsets.size() - 1);
+    }
+}
+
+void SituationGraph::buildTriggerArrays() {
+    // relations default to AND of weight 1, as the evidences were evaluated before
+    auto relationOf = [this](int src, int dest) -> const SituationRelation* {
+        auto it = relationMap.find(edge_id(idAt(src), idAt(dest)));
+        return it == relationMap.end() ? nullptr : &it->second;
+    };
+    int size = nodes.size();
+    causeRelations.resize(causeIndices.size());
+    evidenceRelations.resize(evidenceIndices.size());
+    evidenceWeights.resize(evidenceIndices.size());
+    thresholds.resize(size);
+    for (int i = 0; i < size; i++) {
+        for (int c = causeOffsets[i]; c < causeOffsets[i + 1]; c++) {
+            const SituationRelation* r = relationOf(causeIndices[c], i);
+            causeRelations[c] = r ? r->relation : SituationRelation::AND;
+        }
+        double total = 0;
+        for (int e = evidenceOffsets[i]; e < evidenceOffsets[i + 1]; e++) {
+            const SituationRelation* r = relationOf(evidenceIndices[e], i);
+            evidenceRelations[e] = r ? r->relation : SituationRelation::AND;
+            evidenceWeights[e] = r ? r->weight : 1;
+            total += evidenceWeights[e];
+        }
+        // without a threshold all of the evidence weight is needed
+        thresholds[i] = nodes[i].threshold < 0 ? total : nodes[i].threshold;
+    }
+    evidenceKernel.build(*this);
+}
+
+void SituationGraph::buildEffectArrays() {
+    int size = nodes.size();
+    int count = 0;
+    for (int i = 0; i < size; i++) {
+        count = max(count, getComponentAt(i) + 1);
     }
 
     /*
-     * build reachability matrix
+     * Evidence relations go both ways and stay within a component, so the
+     * components are linked by causes only. Every link leads to a smaller
+     * component number, and in ascending order the effects of a component's
+     * successors are complete before its own.
      */
-    for (int i = 1; i <= size; i++) {
-        vector<vector<bool>> adjMatrixPow = boolMatrixPower(adjMatrix, i);
-        vector<vector<bool>> temp = *ri;
-        boolMatrixAdd(ri, temp, adjMatrixPow);
+    vector<vector<int>> successors(count);
+    for (int i = 0; i < size; i++) {
+        int c = getComponentAt(i);
+        for (auto cause : getCauses(i)) {
+            if (getComponentAt(cause) != c) {
+                successors[getComponentAt(cause)].push_back(c);
+            }
+        }
+    }
+    vector<vector<int>> effects(count);
+    for (int c = 0; c < count; c++) {
+        vector<int>& merged = effects[c];
+        for (auto d : successors[c]) {
+            vector<int> result;
+            const vector<int>& other = effects[d];
+            set_union(merged.begin(), merged.end(), other.begin(), other.end(),
+                    back_inserter(result));
+            merged.swap(result);
+            auto at = lower_bound(merged.begin(), merged.end(), d);
+            if (at == merged.end() || *at != d) {
+                merged.insert(at, d);
+            }
+        }
+    }
 
+    effectOffsets.assign(count + 1, 0);
+    effectComponents.clear();
+    for (int c = 0; c < count; c++) {
+        effectComponents.insert(effectComponents.end(), effects[c].begin(),
+                effects[c].end());
+        effectOffsets[c + 1] = effectComponents.size();
     }
 }
 
-void SituationGraph::loadModel(const std::string &filename, SituationEvolution* se) {
-    // Create a root
-    pt::ptree root;
-    // Load the json file in this ptree
-    pt::read_json(filename, root);
-    int index = 0;
+void SituationGraph::buildReachabilityIndex(set<edge_id>& edges,
+        ReachabilityIndex::Strategy strategy) {
+    /*
+     * map edges onto dense node indices
+     */
+    vector<pair<int, int>> indexedEdges;
+    indexedEdges.reserve(edges.size());
+    for (auto& eid : edges) {
+        int src = indexOf(eid.get<0>());
+        int dest = indexOf(eid.get<1>());
+        if (src != -1 && dest != -1) {
+            indexedEdges.push_back(make_pair(src, dest));
+        }
+    }
 
+    /*
+     * build the index with the requested strategy
+     */
+    unique_ptr<ReachabilityIndex> index = ReachabilityIndex::create(strategy,
+            nodes.size());
+    index->build(nodes.size(), indexedEdges);
+    ri = move(index);
+    buildEffectArrays();
+}
+
+void SituationGraph::loadModel(const std::string &filename,
+        ReachabilityIndex::Strategy strategy) {
     /*
      * for building reachability index
      */
-    set<long> vertices;
     set<edge_id> edges;
 
     /*
-     * Create situation nodes
+     * Create situation nodes and layers, in one pass over the file
      */
-    for (pt::ptree::value_type & layer : root.get_child("layers")) {
-
-        std::map<long, SituationNode> layerMap;
-
-        for (pt::ptree::value_type & node : layer.second) {
-
-            SituationNode situation;
-            long id = node.second.get<long>("ID");
-            situation.id = id;
-            vertices.insert(id);
-            situation.index = index;
-            index++;
-
-            double duration = node.second.get<double>("Duration") / 1000.0;
-            if(node.second.get<string>("Cycle") != "null"){
-                // cycle is in millisecond
-                double cycle = node.second.get<double>("Cycle") / 1000.0;
-                se->addInstance(id, SimTime(duration), SimTime(cycle));
-            }else{
-                se->addInstance(id, SimTime(duration));
-            }
-
-            if (!node.second.get_child("Predecessors").empty()) {
-                for (pt::ptree::value_type &pre : node.second.get_child(
-                        "Predecessors")) {
-                    SituationRelation relation;
-                    long src = pre.second.get<long>("ID");
-                    relation.src = src;
-                    relation.dest = situation.id;
-                    situation.causes.push_back(src);
-                    relation.type = SituationRelation::H;
-                    short relationValue = pre.second.get<short>("Relation");
-                    switch (relationValue) {
-                    case 1:
-                        relation.relation = SituationRelation::AND;
-                        break;
-                    case 2:
-                        relation.relation = SituationRelation::OR;
-                        break;
-                    default:
-                        relation.relation = SituationRelation::SOLE;
-                    }
-                    relation.weight = pre.second.get<double>("Weight-x");
-                    edge_id eid(src, relation.dest);
-                    relationMap[eid] = relation;
-                    edges.insert(eid);
-                }
-            }
-
-            if (!node.second.get_child("Children").empty()) {
-                for (pt::ptree::value_type & chd : node.second.get_child(
-                        "Children")) {
-                    SituationRelation relation;
-                    long src = chd.second.get<long>("ID");
-                    relation.src = src;
-                    relation.dest = situation.id;
-                    situation.evidences.push_back(chd.second.get<long>("ID"));
-                    relation.type = SituationRelation::V;
-                    short relationValue = chd.second.get<short>("Relation");
-                    switch (relationValue) {
-                    case 1:
-                        relation.relation = SituationRelation::AND;
-                        break;
-                    case 2:
-                        relation.relation = SituationRelation::OR;
-                        break;
-                    default:
-                        relation.relation = SituationRelation::SOLE;
-                    }
-                    relation.weight = chd.second.get<double>("Weight-y");
-                    edge_id eid(src, relation.dest);
-                    relationMap[eid] = relation;
-                    edge_id reid(relation.dest, src);
-                    edges.insert(eid);
-                    edges.insert(reid);
-                }
-            }
-
-            layerMap[situation.id] = situation;
-        }
+    ModelReader::read(filename, *this, edges);
 
-        /**
-         * Create situation graph layers
-         */
-        DirectedGraph graph;
-        for (auto m : layerMap) {
-            graph.add_vertex(m.first);
-            SituationNode& node = m.second;
-            for (auto p : node.causes) {
-                graph.add_edge(p, node.id);
-            }
+    /*
+     * Compile relations and layers onto dense indices
+     */
+    buildRelationArrays();
+    for (auto& order : layerOrders) {
+        vector<int> indices;
+        for (auto id : order) {
+            indices.push_back(indexOf(id));
         }
-//        graph.print();
-        layers.push_back(graph);
-
-        // Create mapping relations
-        situationMap.insert(layerMap.begin(), layerMap.end());
+        layerIndices.push_back(indices);
     }
+    buildSupportArrays();
+    buildOperationalArrays();
+    buildLevelArrays();
+    buildTriggerArrays();
 
     /*
      * Create reachability index
      */
-    buildReachabilityMatrix(vertices, edges);
-//    cout << "print reachability matrix" << endl;
-//    for(auto row : *ri){
-//        for(auto col : row){
-//            cout << col << "  ";
-//        }
-//        cout << endl;
-//    }
+    buildReachabilityIndex(edges, strategy);
 }
 
-DirectedGraph SituationGraph::getLayer (int index){
+const DirectedGraph& SituationGraph::getLayer (int index) const {
     return layers[index];
 }
 
-SituationNode SituationGraph::getNode(long id){
-    return situationMap[id];
+const vector<long>& SituationGraph::getLayerOrder(int index) const {
+    return layerOrders[index];
 }
 
-int SituationGraph::modelHeight(){
+const SituationNode& SituationGraph::getNode(long id) const {
+    return nodes.at(indexOf(id));
+}
+
+int SituationGraph::modelHeight() const {
     return layers.size();
 }
 
-void SituationGraph::print() {
-    for (auto m : situationMap) {
-        cout << m.second;
+void SituationGraph::print() const {
+    for (auto& node : nodes) {
+        cout << node;
     }
 }
 
 SituationGraph::~SituationGraph() {
-    // TODO why cannot release pointer here?
-//    delete ri;
+    // TODO Auto-generated destructor stub
 }
-
@@ -18,39 +18,192 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include "boost/tuple/tuple.hpp"
 #include "boost/tuple/tuple_comparison.hpp"
 #include "boost/tuple/tuple_io.hpp"
 #include "SituationNode.h"
 #include "SituationRelation.h"
 #include "DirectedGraph.h"
+#include "ReachabilityIndex.h"
+#include "TriggerKernel.h"
+#include "../common/Span.h"
 
 using namespace std;
 using namespace boost::tuples;
 
-// forward declaration
-class SituationEvolution;
-
+/*
+ * The situation model. It is immutable once loadModel returns, and it is
+ * compiled into dense node indices [0, numNodes()), assigned in load
+ * order, with CSR relation arrays, so that the per-slice loops can walk
+ * it without allocating.
+ */
 class SituationGraph {
 private:
-    map<long, SituationNode> situationMap;
+    // nodes by dense index
+    vector<SituationNode> nodes;
+    // situation ID -> dense index
+    unordered_map<long, int> indexMap;
     typedef boost::tuple<long, long> edge_id;
     map<edge_id, SituationRelation> relationMap;
     vector<DirectedGraph> layers;
-    // reachability index
-    vector<vector<bool>> *ri;
+    // topological order of each layer, frozen at load time
+    vector<vector<long>> layerOrders;
+    vector<vector<int>> layerIndices;
+    // causes and evidences by dense index in CSR layout
+    vector<int> causeOffsets;
+    vector<int> causeIndices;
+    vector<int> evidenceOffsets;
+    vector<int> evidenceIndices;
+    // SituationRelation::Relation of each cause and evidence edge
+    vector<char> causeRelations;
+    vector<char> evidenceRelations;
+    // SituationRelation weight of each evidence edge
+    vector<double> evidenceWeights;
+    // evidence weight each situation needs in weighted reasoning
+    vector<double> thresholds;
+    // reverse evidences: upper situations each situation is evidence of
+    vector<int> supportOffsets;
+    vector<int> supportIndices;
+    // de-duplicated operational situations below each situation, sorted
+    vector<int> operationalOffsets;
+    vector<int> operationalIndices;
+    // layer of each situation and its position in the layer order
+    vector<int> nodeLayers;
+    vector<int> nodePositions;
+    /*
+     * Levels of each layer: a situation is placed after the same-layer
+     * situations it reads (evidences before it in the layer order) or must
+     * be read by (supports before it), so one level can be evaluated in
+     * any order with the result of the sequential sweep. levelNodes holds
+     * the levels one after another, each in layer order.
+     */
+    vector<int> levelNodes;
+    vector<int> levelOffsets;
+    // first level of each layer in levelOffsets
+    vector<int> layerLevels;
+    // trigger condition over the evidences, by level
+    TriggerKernel evidenceKernel;
+    // reachability index, shared read-only between copies of the model
+    shared_ptr<ReachabilityIndex> ri;
+    // components each component of the index strictly reaches, sorted
+    vector<int> effectOffsets;
+    vector<int> effectComponents;
+
+    // reads and writes the precompiled image
+    friend class ModelImage;
+    // streams the JSON source into the model
+    friend class ModelReader;
 
-    void buildReachabilityMatrix(set<long>& vertices, set<edge_id>& edges);
+    void buildRelationArrays();
+    void buildSupportArrays();
+    void buildOperationalArrays();
+    void buildLevelArrays();
+    void buildTriggerArrays();
+    // after the reachability index
+    void buildEffectArrays();
+    void buildReachabilityIndex(set<edge_id>& edges,
+            ReachabilityIndex::Strategy strategy);
 public:
     SituationGraph();
-    vector<long> getAllOperationalSitutions();
-    vector<long> getOperationalSitutions(long topNodeId);
-    bool isReachable(long src, long dest);
-    void loadModel(const std::string &filename, SituationEvolution* arrangeer);
-    DirectedGraph getLayer (int index);
-    int modelHeight();
-    SituationNode getNode(long id);
-    void print();
+    const vector<long>& getAllOperationalSitutions() const;
+    vector<long> getOperationalSitutions(long topNodeId) const;
+    // operational situations below a situation as sorted dense indices
+    Span<int> getOperationalSitutionsAt(int index) const {
+        return Span<int>(operationalIndices.data() + operationalOffsets[index],
+                operationalIndices.data() + operationalOffsets[index + 1]);
+    }
+    bool isReachable(long src, long dest) const;
+    bool isReachableAt(int src, int dest) const {
+        return ri->isReachable(src, dest);
+    }
+    /*
+     * Strongly connected component of a situation. Situations of different
+     * components reach each other at most one way, those of a component
+     * all reach each other.
+     */
+    int getComponentAt(int index) const {
+        return ri->componentOf(index);
+    }
+    int numComponents() const {
+        return effectOffsets.size() - 1;
+    }
+    // the components a component strictly reaches, in ascending order
+    Span<int> getEffectComponents(int component) const {
+        return Span<int>(effectComponents.data() + effectOffsets[component],
+                effectComponents.data() + effectOffsets[component + 1]);
+    }
+    void loadModel(const std::string &filename,
+            ReachabilityIndex::Strategy strategy = ReachabilityIndex::AUTO);
+    const DirectedGraph& getLayer (int index) const;
+    const vector<long>& getLayerOrder(int index) const;
+    // topological order of a layer as dense indices
+    Span<int> getLayerIndices(int index) const {
+        const vector<int>& order = layerIndices[index];
+        return Span<int>(order.data(), order.data() + order.size());
+    }
+    int modelHeight() const;
+    int numNodes() const {
+        return nodes.size();
+    }
+    // dense index of a situation, or -1 if not in the model
+    int indexOf(long id) const {
+        auto it = indexMap.find(id);
+        return it == indexMap.end() ? -1 : it->second;
+    }
+    long idAt(int index) const {
+        return nodes[index].id;
+    }
+    const SituationNode& getNode(long id) const;
+    const SituationNode& getNodeAt(int index) const {
+        return nodes[index];
+    }
+    Span<int> getCauses(int index) const {
+        return Span<int>(causeIndices.data() + causeOffsets[index],
+                causeIndices.data() + causeOffsets[index + 1]);
+    }
+    Span<int> getEvidences(int index) const {
+        return Span<int>(evidenceIndices.data() + evidenceOffsets[index],
+                evidenceIndices.data() + evidenceOffsets[index + 1]);
+    }
+    Span<char> getCauseRelations(int index) const {
+        return Span<char>(causeRelations.data() + causeOffsets[index],
+                causeRelations.data() + causeOffsets[index + 1]);
+    }
+    Span<char> getEvidenceRelations(int index) const {
+        return Span<char>(evidenceRelations.data() + evidenceOffsets[index],
+                evidenceRelations.data() + evidenceOffsets[index + 1]);
+    }
+    Span<double> getEvidenceWeights(int index) const {
+        return Span<double>(evidenceWeights.data() + evidenceOffsets[index],
+                evidenceWeights.data() + evidenceOffsets[index + 1]);
+    }
+    double getThreshold(int index) const {
+        return thresholds[index];
+    }
+    const TriggerKernel& getEvidenceKernel() const {
+        return evidenceKernel;
+    }
+    Span<int> getSupports(int index) const {
+        return Span<int>(supportIndices.data() + supportOffsets[index],
+                supportIndices.data() + supportOffsets[index + 1]);
+    }
+    int getLayerOf(int index) const {
+        return nodeLayers[index];
+    }
+    int getLayerPosition(int index) const {
+        return nodePositions[index];
+    }
+    int numLevels(int layer) const {
+        return layerLevels[layer + 1] - layerLevels[layer];
+    }
+    Span<int> getLevel(int layer, int level) const {
+        int k = layerLevels[layer] + level;
+        return Span<int>(levelNodes.data() + levelOffsets[k],
+                levelNodes.data() + levelOffsets[k + 1]);
+    }
+    void print() const;
     virtual ~SituationGraph();
 };
 
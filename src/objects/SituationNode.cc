@@ -9,7 +9,10 @@
 
 SituationNode::SituationNode() {
     id = -1;
-    threshold = 0;
+    index = -1;
+    threshold = -1;
+    duration = 0;
+    cycle = 0;
 }
 
 SituationNode::~SituationNode() {
@@ -17,7 +17,11 @@ public:
     long id;
     // index in a directed graph for reachability query
     int index;
+    // evidence weight needed in weighted reasoning, negative for all of it
     double threshold;
+    // in second, a cycle of 0 means no gap between occurrences
+    double duration;
+    double cycle;
     vector<long> causes;
     vector<long> evidences;
 public:
@@ -26,7 +30,8 @@ public:
 };
 
 inline std::ostream& operator<<(std::ostream &os, const SituationNode &s) {
-    os << "situation (" << s.id << "): threshold " << s.threshold << endl;
+    os << "situation (" << s.id << "): threshold " << s.threshold
+            << ", duration " << s.duration << ", cycle " << s.cycle << endl;
     os << "causes (" << s.causes.size() << "): ";
     for(auto cause : s.causes){
         os << cause << ", ";
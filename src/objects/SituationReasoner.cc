@@ -13,77 +13,95 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include <algorithm>
 #include "../common/Util.h"
 #include "SituationReasoner.h"
+#include "SweepEngine.h"
 
 SituationReasoner::SituationReasoner() :
         SituationEvolution() {
-    // TODO Auto-generated constructor stub
+    engine.reset(new SweepEngine());
+    firedAt = -1;
+}
+
+void SituationReasoner::setModel(shared_ptr<const SituationGraph> sg) {
+    if (!engine->accepts(*sg)) {
+        throw cRuntimeError("Reasoning engine does not accept the model");
+    }
+    SituationEvolution::setModel(sg);
 
+    expiries = decltype(expiries)();
+    stamps.assign(sg->numNodes(), 0);
+    fired.clear();
+    firedAt = -1;
+    engine->attach(*this);
+}
+
+bool SituationReasoner::load(BinaryReader& in, simtime_t shift) {
+    if (!SituationEvolution::load(in, shift)) {
+        return false;
+    }
+    expiries = decltype(expiries)();
+    stamps.assign(sg->numNodes(), 0);
+    fired.clear();
+    firedAt = -1;
+    for (int i = 0; i < sg->numNodes(); i++) {
+        if (states[i] == SituationInstance::TRIGGERED) {
+            pushExpiry(i);
+        }
+    }
+    engine->attach(*this);
+    return true;
+}
+
+void SituationReasoner::setEngine(unique_ptr<ReasoningEngine> engine) {
+    if (sg && !engine->accepts(*sg)) {
+        throw cRuntimeError("Reasoning engine does not accept the model");
+    }
+    this->engine = move(engine);
+    if (sg) {
+        this->engine->attach(*this);
+    }
 }
 
 SituationReasoner::~SituationReasoner() {
     // TODO Auto-generated destructor stub
 }
 
-set<long> SituationReasoner::reason(set<long> triggered, simtime_t current) {
-    set<long> tOperational;
+SituationSet SituationReasoner::reason(Span<int> triggered, simtime_t current,
+        pmr::memory_resource* memory) {
+    SituationSet tOperational(memory);
 
 //    cout << "show triggered: ";
 //    util::printSet(triggered);
 
-    int numOfLayers = sg.modelHeight();
-    // trigger bottom layer situations
-    DirectedGraph g = sg.getLayer(numOfLayers - 1);
-    vector<long> bottoms = g.topo_sort();
-    for (auto bottom : bottoms) {
-        SituationInstance& instance = instanceMap[bottom];
-        auto it = triggered.find(bottom);
-        if (it != triggered.end()) {
-            instance.state = SituationInstance::TRIGGERED;
-            instance.counter++;
-            instance.next_start = current;
-        }
+    int bottomLayer = sg->modelHeight() - 1;
+    if (firedAt != current) {
+        fired.clear();
+        firedAt = current;
     }
 
-    for (int i = numOfLayers - 1; i > 0; i--) {
-        DirectedGraph g1 = sg.getLayer(i - 1);
-        vector<long> uppers = g1.topo_sort();
-        for (auto upper : uppers) {
-            SituationInstance& instance = instanceMap[upper];
-            SituationNode node = sg.getNode(instance.id);
-            bool toTrigger = true;
-            for (auto evidence : node.evidences) {
-                SituationInstance& es = instanceMap[evidence];
-                if (es.counter <= instance.counter) {
-                    toTrigger = false;
-                    break;
-                }
-            }
-            if (toTrigger) {
-                instance.state = SituationInstance::TRIGGERED;
-                instance.counter++;
-                instance.next_start = current;
-            }
+    // trigger bottom layer situations
+    size_t first = fired.size();
+    for (auto bottom : triggered) {
+        if (sg->getLayerOf(bottom) == bottomLayer) {
+            trigger(bottom, current);
+            fired.push_back(bottom);
         }
     }
+    engine->sweep(Span<int>(fired.data() + first, fired.data() + fired.size()),
+            current);
 
     // get operational situations from the bottom layer
-    for (auto bottom : bottoms) {
-        SituationInstance& instance = instanceMap[bottom];
-        if (instance.state == SituationInstance::TRIGGERED
-                && instance.next_start == current) {
-            tOperational.insert(instance.id);
+    for (auto bottom : fired) {
+        if (states[bottom] == SituationInstance::TRIGGERED
+                && nextStarts[bottom] == current) {
+            tOperational.insert(sg->idAt(bottom));
         }
     }
 
     // reset transient situations
-    for (auto& si : instanceMap) {
-        if (si.second.next_start + si.second.duration <= current) {
-            si.second.state = SituationInstance::UNTRIGGERED;
-        }
-    }
-
+    checkState(current);
 
 //    cout << "print situation graph instance" << endl;
 //    print();
@@ -91,11 +109,55 @@ set<long> SituationReasoner::reason(set<long> triggered, simtime_t current) {
     return tOperational;
 }
 
-void SituationReasoner::checkState(simtime_t current) {
-    // reset transient situations
-    for (auto si : instanceMap) {
-        if (si.second.next_start + si.second.duration <= current) {
-            si.second.state = SituationInstance::UNTRIGGERED;
+SituationSet SituationReasoner::reason(const set<long>& triggered,
+        simtime_t current) {
+    vector<int> indices;
+    for (auto id : triggered) {
+        int index = sg->indexOf(id);
+        if (index != -1) {
+            indices.push_back(index);
         }
     }
+    sort(indices.begin(), indices.end());
+    return reason(Span<int>(indices.data(), indices.data() + indices.size()),
+            current);
+}
+
+void SituationReasoner::trigger(int index, simtime_t current) {
+    mark(index, current);
+    pushExpiry(index);
+}
+
+void SituationReasoner::pushExpiry(int index) {
+    Expiry expiry;
+    expiry.deadline = nextStarts[index] + durations[index];
+    expiry.index = index;
+    expiry.stamp = ++stamps[index];
+    expiries.push(expiry);
+}
+
+void SituationReasoner::prune() {
+    while (!expiries.empty()
+            && expiries.top().stamp != stamps[expiries.top().index]) {
+        expiries.pop();
+    }
+}
+
+void SituationReasoner::checkState(simtime_t current) {
+    // reset transient situations, only those that are due are touched
+    prune();
+    while (!expiries.empty() && expiries.top().deadline <= current) {
+        states[expiries.top().index] = SituationInstance::UNTRIGGERED;
+        expiries.pop();
+        prune();
+    }
+}
+
+bool SituationReasoner::nextDeadline(simtime_t& deadline) {
+    prune();
+    if (expiries.empty()) {
+        return false;
+    }
+    deadline = expiries.top().deadline;
+    return true;
 }
@@ -17,19 +17,74 @@
 #define OBJECTS_SITUATIONREASONER_H_
 
 #include <omnetpp.h>
+#include <memory_resource>
+#include <queue>
+#include <vector>
+#include "ReasoningEngine.h"
 #include "SituationEvolution.h"
 
 using namespace omnetpp;
 using namespace std;
 
+/*
+ * Triggers the bottom situations in a slice and leaves the upper ones to
+ * its ReasoningEngine, a SweepEngine unless set otherwise.
+ */
 class SituationReasoner: public SituationEvolution {
+    friend class ReasoningEngine;
 private:
+    struct Expiry {
+        simtime_t deadline;
+        int index;
+        // matches stamps[index] unless the situation retriggered since
+        unsigned stamp;
+        bool operator>(const Expiry& other) const {
+            return deadline > other.deadline;
+        }
+    };
+
+    unique_ptr<ReasoningEngine> engine;
+    // deadlines of triggered situations, earliest first
+    priority_queue<Expiry, vector<Expiry>, greater<Expiry>> expiries;
+    vector<unsigned> stamps;
+    // bottom situations triggered at firedAt
+    vector<int> fired;
+    simtime_t firedAt;
+
+    void trigger(int index, simtime_t current);
+    // the state change of trigger, without the expiry
+    void mark(int index, simtime_t current) {
+        states[index] = SituationInstance::TRIGGERED;
+        counters[index]++;
+        nextStarts[index] = current;
+    }
+    void pushExpiry(int index);
+    // drop stale entries from the top of the expiry queue
+    void prune();
 public:
     SituationReasoner();
-    // return a set of triggered operational situations
-    set<long> reason(set<long> triggered, simtime_t current);
+    // throws if the engine does not accept the model
+    void setModel(shared_ptr<const SituationGraph> sg) override;
+    // the expiries are rebuilt from the restored instances
+    bool load(BinaryReader& in, simtime_t shift) override;
+    /*
+     * Reason with engine from now on, e.g. one of ReasoningEngine::create.
+     * Throws if a model is set that the engine does not accept.
+     */
+    void setEngine(unique_ptr<ReasoningEngine> engine);
+    /*
+     * Trigger the given bottom situations, dense indices in ascending
+     * order as drained from a TriggerBuffer, and return a set of triggered
+     * operational situations, allocated from memory, e.g. a SliceArena
+     */
+    SituationSet reason(Span<int> triggered, simtime_t current,
+            pmr::memory_resource* memory = pmr::get_default_resource());
+    // same by situation ID, e.g. for tools
+    SituationSet reason(const set<long>& triggered, simtime_t current);
     // reset durable situations if timeout
     void checkState(simtime_t current);
+    // earliest pending expiry, false if none
+    bool nextDeadline(simtime_t& deadline);
     virtual ~SituationReasoner();
 };
 
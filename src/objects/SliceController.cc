@@ -0,0 +1,77 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <algorithm>
+#include "SliceController.h"
+
+SliceController::SliceController() {
+    adaptive = false;
+    minimum = 3;
+    maximum = 3;
+    targetEvents = 0;
+    rate = 0;
+    cost = 0;
+    primed = false;
+    arrivals = 0;
+    lastSlice = 0;
+    interval = 3;
+}
+
+void SliceController::setFixed(simtime_t cycle) {
+    adaptive = false;
+    minimum = cycle;
+    maximum = cycle;
+    interval = cycle;
+}
+
+void SliceController::setAdaptive(simtime_t initial, simtime_t minimum,
+        simtime_t maximum, double targetEvents) {
+    adaptive = true;
+    this->minimum = minimum;
+    this->maximum = maximum;
+    this->targetEvents = targetEvents;
+    interval = std::min(std::max(initial, minimum), maximum);
+}
+
+simtime_t SliceController::next(simtime_t now, bool backlog,
+        double sliceCost) {
+    double elapsed = (now - lastSlice).dbl();
+    double observed = elapsed > 0 ? arrivals / elapsed : 0;
+    if (primed) {
+        rate = ALPHA * observed + (1 - ALPHA) * rate;
+        cost = ALPHA * sliceCost + (1 - ALPHA) * cost;
+    } else {
+        rate = observed;
+        cost = sliceCost;
+        primed = true;
+    }
+    arrivals = 0;
+    lastSlice = now;
+    if (!adaptive) {
+        return interval;
+    }
+
+    double length;
+    if (backlog) {
+        length = minimum.dbl();
+    } else if (observed == 0 || rate <= 0) {
+        length = maximum.dbl();
+    } else {
+        length = targetEvents / rate;
+    }
+    length = std::max(length, COST_FACTOR * cost);
+    interval = std::min(std::max(simtime_t(length), minimum), maximum);
+    return interval;
+}
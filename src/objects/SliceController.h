@@ -0,0 +1,79 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_SLICECONTROLLER_H_
+#define OBJECTS_SLICECONTROLLER_H_
+
+#include <omnetpp.h>
+
+using namespace omnetpp;
+
+/*
+ * Length of the synchronizer's time slices. Fixed slices are always of
+ * the nominal cycle. Adaptive slices follow the load, within
+ * [minimum, maximum]:
+ *
+ * - with a backlog, triggers that need further slices to be reasoned
+ *   about, the next slice is as short as allowed;
+ * - otherwise it is sized to take about targetEvents events at the
+ *   smoothed arrival rate, and idle periods get the longest slice;
+ * - a slice is never shorter than COST_FACTOR times the smoothed
+ *   wall-clock cost of a slice, which bounds the reasoning share of the
+ *   processor under load.
+ */
+class SliceController {
+private:
+    bool adaptive;
+    simtime_t minimum;
+    simtime_t maximum;
+    double targetEvents;
+    // smoothed events per simulated second, and wall-clock seconds per slice
+    double rate;
+    double cost;
+    bool primed;
+    // events since the last slice
+    long arrivals;
+    simtime_t lastSlice;
+    simtime_t interval;
+public:
+    // weight of the latest slice in the smoothed rate and cost
+    static constexpr double ALPHA = 0.3;
+    static constexpr double COST_FACTOR = 10;
+
+    SliceController();
+    void setFixed(simtime_t cycle);
+    void setAdaptive(simtime_t initial, simtime_t minimum, simtime_t maximum,
+            double targetEvents);
+    bool isAdaptive() const {
+        return adaptive;
+    }
+    void countArrival() {
+        arrivals++;
+    }
+    /*
+     * Length of the slice starting at now, after one that left a backlog
+     * or not and cost the given wall-clock seconds.
+     */
+    simtime_t next(simtime_t now, bool backlog, double sliceCost);
+    // length of the current slice
+    simtime_t getInterval() const {
+        return interval;
+    }
+    double getRate() const {
+        return rate;
+    }
+};
+
+#endif /* OBJECTS_SLICECONTROLLER_H_ */
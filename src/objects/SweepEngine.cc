@@ -0,0 +1,97 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <algorithm>
+#include "SweepEngine.h"
+
+SweepEngine::SweepEngine(Mode mode, int threads, size_t grain) {
+    this->mode = mode;
+    if (threads != 1) {
+        pool.reset(new ThreadPool(threads));
+    }
+    this->grain = max<size_t>(grain, 1);
+}
+
+void SweepEngine::sweep(Span<int> /* bottoms */, simtime_t current) {
+    for (int i = sg->modelHeight() - 1; i > 0; i--) {
+        sweepLayer(i - 1, current);
+    }
+}
+
+void SweepEngine::sweepChunk(size_t c) {
+    const TriggerKernel& kernel = sg->getEvidenceKernel();
+    vector<int>& hits = chunkTriggered[c];
+    hits.clear();
+    size_t first = c * level.step;
+    size_t last = min(level.situations.size(), (c + 1) * level.step);
+    if (mode == WEIGHTED) {
+        kernel.accumulate(level.layer, level.level, first, last, counters(),
+                hits);
+    } else {
+        kernel.evaluate(level.layer, level.level, first, last, counters(),
+                chunkBits[c], hits);
+    }
+    for (auto index : hits) {
+        mark(index, level.current);
+    }
+}
+
+void SweepEngine::sweepLayer(int layer, simtime_t current) {
+    bool parallel = pool && pool->size() >= 2
+            && sg->getLayerIndices(layer).size() >= grain;
+
+    /*
+     * A level only reads counters of earlier levels, or of its own
+     * situations, so it is evaluated in one go, and in parallel chunks of
+     * grain situations on the pool. The expiries are queued afterwards in
+     * layer order, as a one-by-one sweep does. The tasks only capture the
+     * chunk, small enough for a function without a heap allocation.
+     */
+    layerTriggered.clear();
+    int levels = sg->numLevels(layer);
+    for (int k = 0; k < levels; k++) {
+        Span<int> situations = sg->getLevel(layer, k);
+        size_t step = parallel ? grain : situations.size();
+        size_t chunks = (situations.size() + step - 1) / step;
+        if (chunkTriggered.size() < chunks) {
+            chunkTriggered.resize(chunks);
+            chunkBits.resize(chunks);
+        }
+        level = { layer, k, situations, step, current };
+        if (chunks == 1) {
+            sweepChunk(0);
+        } else {
+            tasks.clear();
+            for (size_t c = 0; c < chunks; c++) {
+                tasks.push_back([this, c] {
+                    sweepChunk(c);
+                });
+            }
+            pool->run(tasks);
+        }
+        for (size_t c = 0; c < chunks; c++) {
+            layerTriggered.insert(layerTriggered.end(),
+                    chunkTriggered[c].begin(), chunkTriggered[c].end());
+        }
+    }
+    if (levels > 1) {
+        sort(layerTriggered.begin(), layerTriggered.end(), [this](int a, int b) {
+            return sg->getLayerPosition(a) < sg->getLayerPosition(b);
+        });
+    }
+    for (auto index : layerTriggered) {
+        pushExpiry(index);
+    }
+}
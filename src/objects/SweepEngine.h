@@ -0,0 +1,58 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef OBJECTS_SWEEPENGINE_H_
+#define OBJECTS_SWEEPENGINE_H_
+
+#include <memory>
+#include <vector>
+#include "../common/ThreadPool.h"
+#include "ReasoningEngine.h"
+
+/*
+ * Full sweep: every upper situation is evaluated in every slice with the
+ * trigger kernel, a level of a layer at a time. With more than one thread
+ * the levels of layers of at least grain situations are swept in chunks
+ * of grain situations on a pool of its own.
+ */
+class SweepEngine: public ReasoningEngine {
+private:
+    Mode mode;
+    unique_ptr<ThreadPool> pool;
+    size_t grain;
+    vector<ThreadPool::Task> tasks;
+    vector<vector<int>> chunkTriggered;
+    vector<vector<uint64_t>> chunkBits;
+    vector<int> layerTriggered;
+    // level being swept, read by the chunk tasks
+    struct Sweep {
+        int layer;
+        int level;
+        Span<int> situations;
+        size_t step;
+        simtime_t current;
+    } level;
+
+    // evaluate all situations of an upper layer with the trigger kernel
+    void sweepLayer(int layer, simtime_t current);
+    void sweepChunk(size_t chunk);
+public:
+    // threads as for ThreadPool, 0 for one per hardware thread
+    explicit SweepEngine(Mode mode = BOOLEAN, int threads = 1,
+            size_t grain = 1024);
+    void sweep(Span<int> bottoms, simtime_t current) override;
+};
+
+#endif /* OBJECTS_SWEEPENGINE_H_ */
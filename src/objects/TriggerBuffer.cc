@@ -0,0 +1,114 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#include <algorithm>
+#include "TriggerBuffer.h"
+
+TriggerBuffer::TriggerBuffer() {
+    total = 0;
+}
+
+void TriggerBuffer::setModel(shared_ptr<const SituationGraph> sg) {
+    this->sg = sg;
+    counts.assign(sg->numNodes(), 0);
+    listed.assign(sg->numNodes(), 0);
+    active.clear();
+    drained.clear();
+    total = 0;
+}
+
+bool TriggerBuffer::add(long id) {
+    int index = sg->indexOf(id);
+    if (index == -1) {
+        return false;
+    }
+    counts[index]++;
+    if (!listed[index]) {
+        listed[index] = 1;
+        active.push_back(index);
+    }
+    total++;
+    return true;
+}
+
+void TriggerBuffer::limit(int index, int count) {
+    if (counts[index] > count) {
+        total -= counts[index] - max(count, 0);
+        counts[index] = max(count, 0);
+    }
+}
+
+void TriggerBuffer::save(BinaryWriter& out) const {
+    vector<int32_t> counted;
+    vector<int> indices;
+    for (auto index : active) {
+        if (counts[index] > 0) {
+            indices.push_back(index);
+            counted.push_back(counts[index]);
+        }
+    }
+    out.putArray(indices);
+    out.putArray(counted);
+}
+
+bool TriggerBuffer::load(BinaryReader& in) {
+    vector<int> indices;
+    vector<int32_t> counted;
+    if (!in.getArray(indices) || !in.getArray(counted)
+            || indices.size() != counted.size()) {
+        return false;
+    }
+    for (auto index : active) {
+        counts[index] = 0;
+        listed[index] = 0;
+    }
+    active.clear();
+    total = 0;
+    for (size_t i = 0; i < indices.size(); i++) {
+        int index = indices[i];
+        if (index < 0 || index >= sg->numNodes() || counted[i] <= 0
+                || counts[index] > 0) {
+            return false;
+        }
+        counts[index] = counted[i];
+        listed[index] = 1;
+        active.push_back(index);
+        total += counted[i];
+    }
+    return true;
+}
+
+Span<int> TriggerBuffer::drain() {
+    // situations added since the last drain are appended out of order
+    sort(active.begin(), active.end());
+    drained.clear();
+    size_t kept = 0;
+    for (auto index : active) {
+        // limited to 0 since the last drain
+        if (counts[index] == 0) {
+            listed[index] = 0;
+            continue;
+        }
+        drained.push_back(index);
+        if (--counts[index] > 0) {
+            active[kept++] = index;
+        } else {
+            listed[index] = 0;
+        }
+    }
+    active.resize(kept);
+    total -= drained.size();
+    return Span<int>(drained.data(), drained.data() + drained.size());
+}
@@ -0,0 +1,72 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_TRIGGERBUFFER_H_
+#define OBJECTS_TRIGGERBUFFER_H_
+
+#include <memory>
+#include <vector>
+#include "../common/BinaryIO.h"
+#include "../common/Span.h"
+#include "SituationGraph.h"
+
+using namespace std;
+
+/*
+ * Triggering events buffered per situation until a slice reasons about
+ * them, one per situation and slice. Counts are kept by dense index, with
+ * a list of the situations that have any, so that a slice only visits
+ * those and never allocates once the lists have grown.
+ *
+ * The counts follow the cached events: where the overflow or merge
+ * policy drops, folds or cancels triggering events, the caller limits
+ * the count to the triggers the events still make.
+ */
+class TriggerBuffer {
+private:
+    shared_ptr<const SituationGraph> sg;
+    vector<int> counts;
+    // indices with a count above 0, ascending after a drain, and those
+    // limited to 0 since
+    vector<int> active;
+    vector<char> listed;
+    // result of the last drain
+    vector<int> drained;
+    long total;
+public:
+    TriggerBuffer();
+    void setModel(shared_ptr<const SituationGraph> sg);
+    // false if the situation is not in the model
+    bool add(long id);
+    // lower the count of a situation by dense index to at most count
+    void limit(int index, int count);
+    /*
+     * Take one trigger of every situation with any. The dense indices come
+     * in ascending order and stay valid until the next drain.
+     */
+    Span<int> drain();
+    // the buffered triggers of a RuntimeSnapshot
+    void save(BinaryWriter& out) const;
+    bool load(BinaryReader& in);
+    // buffered triggers
+    long size() const {
+        return total;
+    }
+    bool empty() const {
+        return total == 0;
+    }
+};
+
+#endif /* OBJECTS_TRIGGERBUFFER_H_ */
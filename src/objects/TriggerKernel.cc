@@ -0,0 +1,184 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#include "SituationGraph.h"
+#include "TriggerKernel.h"
+
+void TriggerKernel::build(const SituationGraph& sg) {
+    slotNodes.clear();
+    edgeOffsets.assign(1, 0);
+    orStarts.clear();
+    sources.clear();
+    owners.clear();
+    weights.clear();
+    slotThresholds.clear();
+    levelSlots.assign(1, 0);
+    layerLevels.assign(1, 0);
+
+    for (int l = 0; l < sg.modelHeight(); l++) {
+        for (int k = 0; k < sg.numLevels(l); k++) {
+            for (auto index : sg.getLevel(l, k)) {
+                Span<int> evidences = sg.getEvidences(index);
+                Span<char> relations = sg.getEvidenceRelations(index);
+                Span<double> edgeWeights = sg.getEvidenceWeights(index);
+                slotNodes.push_back(index);
+                slotThresholds.push_back(sg.getThreshold(index));
+                for (int pass = 0; pass < 2; pass++) {
+                    if (pass == 1) {
+                        orStarts.push_back(sources.size());
+                    }
+                    for (size_t e = 0; e < evidences.size(); e++) {
+                        if ((relations[e] == SituationRelation::OR) == (pass == 1)) {
+                            sources.push_back(evidences[e]);
+                            owners.push_back(index);
+                            weights.push_back(edgeWeights[e]);
+                        }
+                    }
+                }
+                edgeOffsets.push_back(sources.size());
+            }
+            levelSlots.push_back(slotNodes.size());
+        }
+        layerLevels.push_back(levelSlots.size() - 1);
+    }
+}
+
+void TriggerKernel::satisfiedBits(const int* sources, const int* owners,
+        size_t count, const int* counters, uint64_t* bits) {
+    size_t k = 0;
+#ifdef __AVX2__
+    for (; k + 64 <= count; k += 64) {
+        uint64_t word = 0;
+        for (int j = 0; j < 64; j += 8) {
+            __m256i s = _mm256_loadu_si256((const __m256i*) (sources + k + j));
+            __m256i o = _mm256_loadu_si256((const __m256i*) (owners + k + j));
+            __m256i cs = _mm256_i32gather_epi32(counters, s, 4);
+            __m256i co = _mm256_i32gather_epi32(counters, o, 4);
+            int mask = _mm256_movemask_ps(
+                    _mm256_castsi256_ps(_mm256_cmpgt_epi32(cs, co)));
+            word |= (uint64_t) (unsigned) mask << j;
+        }
+        bits[k >> 6] = word;
+    }
+#endif
+    for (; k < count; k += 64) {
+        size_t n = count - k < 64 ? count - k : 64;
+        uint64_t word = 0;
+        for (size_t j = 0; j < n; j++) {
+            word |= (uint64_t) (counters[sources[k + j]]
+                    > counters[owners[k + j]]) << j;
+        }
+        bits[k >> 6] = word;
+    }
+}
+
+// bits [lo, hi) of the bitmap, as mask of the word holding bit lo
+static inline uint64_t rangeMask(size_t lo, size_t hi) {
+    size_t end = hi - (lo & ~(size_t) 63);
+    uint64_t mask = ~(uint64_t) 0 << (lo & 63);
+    if (end < 64) {
+        mask &= ((uint64_t) 1 << end) - 1;
+    }
+    return mask;
+}
+
+static bool allSet(const uint64_t* bits, size_t lo, size_t hi) {
+    while (lo < hi) {
+        uint64_t mask = rangeMask(lo, hi);
+        if ((bits[lo >> 6] & mask) != mask) {
+            return false;
+        }
+        lo = (lo | 63) + 1;
+    }
+    return true;
+}
+
+static bool anySet(const uint64_t* bits, size_t lo, size_t hi) {
+    while (lo < hi) {
+        if (bits[lo >> 6] & rangeMask(lo, hi)) {
+            return true;
+        }
+        lo = (lo | 63) + 1;
+    }
+    return false;
+}
+
+void TriggerKernel::evaluate(int layer, int level, size_t first, size_t last,
+        const int* counters, vector<uint64_t>& bits,
+        vector<int>& triggered) const {
+    size_t slot = levelSlots[layerLevels[layer] + level];
+    size_t begin = edgeOffsets[slot + first];
+    size_t count = edgeOffsets[slot + last] - begin;
+    bits.resize((count + 63) / 64);
+    satisfiedBits(sources.data() + begin, owners.data() + begin, count,
+            counters, bits.data());
+
+    for (size_t s = slot + first; s < slot + last; s++) {
+        size_t lo = edgeOffsets[s] - begin;
+        size_t mid = orStarts[s] - begin;
+        size_t hi = edgeOffsets[s + 1] - begin;
+        if (allSet(bits.data(), lo, mid)
+                && (mid == hi || anySet(bits.data(), mid, hi))) {
+            triggered.push_back(slotNodes[s]);
+        }
+    }
+}
+
+double TriggerKernel::weightedSum(const int* sources, const double* weights,
+        size_t count, const int* counters, int counter) {
+    size_t k = 0;
+    double sum = 0;
+#ifdef __AVX2__
+    if (count >= 4) {
+        __m128i c = _mm_set1_epi32(counter);
+        __m256d acc = _mm256_setzero_pd();
+        for (; k + 4 <= count; k += 4) {
+            __m128i s = _mm_loadu_si128((const __m128i*) (sources + k));
+            __m128i v = _mm_i32gather_epi32(counters, s, 4);
+            // widen the 32-bit compare mask to the 64-bit weight lanes
+            __m256d mask = _mm256_castsi256_pd(
+                    _mm256_cvtepi32_epi64(_mm_cmpgt_epi32(v, c)));
+            acc = _mm256_add_pd(acc,
+                    _mm256_and_pd(mask, _mm256_loadu_pd(weights + k)));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc);
+        sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+#endif
+    for (; k < count; k++) {
+        if (counters[sources[k]] > counter) {
+            sum += weights[k];
+        }
+    }
+    return sum;
+}
+
+void TriggerKernel::accumulate(int layer, int level, size_t first,
+        size_t last, const int* counters, vector<int>& triggered) const {
+    size_t slot = levelSlots[layerLevels[layer] + level];
+    for (size_t s = slot + first; s < slot + last; s++) {
+        int lo = edgeOffsets[s];
+        int index = slotNodes[s];
+        double sum = weightedSum(sources.data() + lo, weights.data() + lo,
+                edgeOffsets[s + 1] - lo, counters, counters[index]);
+        if (reaches(sum, slotThresholds[s])) {
+            triggered.push_back(index);
+        }
+    }
+}
@@ -0,0 +1,110 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+#ifndef OBJECTS_TRIGGERKERNEL_H_
+#define OBJECTS_TRIGGERKERNEL_H_
+
+#include <cstdint>
+#include <vector>
+#include "SituationRelation.h"
+#include "../common/Span.h"
+
+using namespace std;
+
+class SituationGraph;
+
+/*
+ * Trigger condition of situations over their evidences (or causes). An
+ * edge is satisfied if the counter of its source is above the counter of
+ * the situation. AND and SOLE edges must all be satisfied, and of the OR
+ * edges, if any, at least one.
+ *
+ * For the full sweep the evidences of each level are laid out in one
+ * edge array, OR edges last per situation. evaluate() computes the
+ * satisfied bits of a run of situations in one pass over the edges, eight
+ * at a time with AVX2 gathers if built with -mavx2, and then tests each
+ * situation's bit ranges word by word.
+ *
+ * In weighted reasoning a situation triggers instead if the weights of
+ * its satisfied evidences sum up to its threshold. accumulate() computes
+ * these sums as a sparse matrix-vector product over the same layout, one
+ * row per situation, four edges at a time with AVX2.
+ */
+class TriggerKernel {
+private:
+    // situations slot by slot, levels one after another
+    vector<int> slotNodes;
+    // edge range of each slot, and where its OR edges start
+    vector<int> edgeOffsets;
+    vector<int> orStarts;
+    // source and owning situation of each edge
+    vector<int> sources;
+    vector<int> owners;
+    // weight of each edge, and threshold of each slot
+    vector<double> weights;
+    vector<double> slotThresholds;
+    // first slot of each level, and first level of each layer
+    vector<int> levelSlots;
+    vector<int> layerLevels;
+
+    static void satisfiedBits(const int* sources, const int* owners,
+            size_t count, const int* counters, uint64_t* bits);
+public:
+    // slack of the threshold test for the rounding of the sums
+    static constexpr double WEIGHT_EPSILON = 1e-9;
+
+    void build(const SituationGraph& sg);
+
+    /*
+     * Append the situations of slots [first, last) of a level whose
+     * condition holds to triggered, in level order. bits is scratch space.
+     */
+    void evaluate(int layer, int level, size_t first, size_t last,
+            const int* counters, vector<uint64_t>& bits,
+            vector<int>& triggered) const;
+
+    /*
+     * Append the situations of slots [first, last) of a level whose
+     * weighted evidence reaches the threshold to triggered, in level order.
+     */
+    void accumulate(int layer, int level, size_t first, size_t last,
+            const int* counters, vector<int>& triggered) const;
+
+    // weight of the satisfied edges of one situation
+    static double weightedSum(const int* sources, const double* weights,
+            size_t count, const int* counters, int counter);
+    static bool reaches(double sum, double threshold) {
+        return sum >= threshold - WEIGHT_EPSILON;
+    }
+
+    // condition of one situation, sources with their relations
+    static bool satisfied(Span<int> sources, Span<char> relations,
+            const int* counters, int counter) {
+        bool hasOr = false;
+        bool anyOr = false;
+        for (size_t k = 0; k < sources.size(); k++) {
+            bool s = counters[sources[k]] > counter;
+            if (relations[k] == SituationRelation::OR) {
+                hasOr = true;
+                anyOr |= s;
+            } else if (!s) {
+                return false;
+            }
+        }
+        return !hasOr || anyOr;
+    }
+};
+
+#endif /* OBJECTS_TRIGGERKERNEL_H_ */
@@ -15,13 +15,7 @@
 
 #include "VirtualOperation.h"
 
-VirtualOperation::VirtualOperation() :
-        Operation() {
-    // TODO Auto-generated constructor stub
-
-}
-
-VirtualOperation::~VirtualOperation() {
-    // TODO Auto-generated destructor stub
+ostream& operator<<(ostream& os, const VirtualOperation& o) {
+    os << (const Operation&) o << " count " << o.count;
+    return os;
 }
-
@@ -18,18 +18,15 @@
 
 #include "Operation.h"
 
-class VirtualOperation: public Operation {
-public:
-    int count;
-protected:
-    // print has to be a constant method, as the caller is a constant
-    void print(ostream& os) const{
-        Operation::print(os);
-        os << " count " << count;
-    }
-public:
-    VirtualOperation();
-    virtual ~VirtualOperation();
+struct VirtualOperation: public Operation {
+    int count = 0;
+    // state variable the operation updates
+    long svId = 0;
 };
 
+ostream& operator<<(ostream& os, const VirtualOperation& o);
+
+static_assert(is_trivially_copyable<VirtualOperation>::value,
+        "VirtualOperation is a record");
+
 #endif /* OBJECTS_VIRTUALOPERATION_H_ */
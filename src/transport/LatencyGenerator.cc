@@ -13,32 +13,148 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/.
 // 
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 #include "LatencyGenerator.h"
 
 LatencyGenerator::LatencyGenerator() {
-    // TODO Auto-generated constructor stub
+    // 50 ms plus half a lognormal(3, 1) ms of jitter
+    model = LOGNORMAL;
+    rng = nullptr;
+    minLatency = 0.05;
+    mu = 3;
+    sigma = 1;
+    paretoShape = 1.5;
+    paretoScale = 0.005;
+    traceNext = 0;
+    linkDelay = 0;
+}
 
+bool LatencyGenerator::parseModel(const string& name, Model& model) {
+    if (name == "constant") {
+        model = CONSTANT;
+    } else if (name == "lognormal") {
+        model = LOGNORMAL;
+    } else if (name == "pareto") {
+        model = PARETO;
+    } else if (name == "trace") {
+        model = TRACE;
+    } else {
+        return false;
+    }
+    return true;
 }
 
-simtime_t LatencyGenerator::generator_latency(){
-    // assume minimum latency is 50 ms
-    double min_latency = 50;
-    // mu = 1 in the lognormal distribution of jitter
-    double mu = 3;
-    // sigma = 0.5 in the lognormal distribution of jitter
-    double sigma = 1;
-    // calculate one-way jitter
-    double var_latency = lognormal(getEnvir()->getRNG(0), mu, sigma) / 2;
-    // calculate the variable latency
-//    double var_latency = exponential(getEnvir()->getRNG(0), 1 / jitter);
-    simtime_t delay = (min_latency + var_latency) / 1000;
+void LatencyGenerator::loadTrace(const string& filename) {
+    ifstream in(filename);
+    if (!in) {
+        throw cRuntimeError("Cannot open latency trace '%s'", filename.c_str());
+    }
+    trace.clear();
+    string line;
+    while (getline(in, line)) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == string::npos || line[start] == '#') {
+            continue;
+        }
+        istringstream fields(line);
+        double latency;
+        if (!(fields >> latency) || latency < 0) {
+            throw cRuntimeError("Malformed latency '%s' in '%s'", line.c_str(),
+                    filename.c_str());
+        }
+        trace.push_back(latency / 1000);
+    }
+    if (trace.empty()) {
+        throw cRuntimeError("No latencies in '%s'", filename.c_str());
+    }
+    traceNext = 0;
+}
 
-//    cout << "delay " << delay << ", var_latency " << var_latency << endl;
+void LatencyGenerator::configure(cComponent* module) {
+    if (!parseModel(module->par("latencyModel").stdstringValue(), model)) {
+        throw cRuntimeError("Unknown latency model '%s'",
+                module->par("latencyModel").stringValue());
+    }
+    rng = module->getRNG(0);
+    minLatency = module->par("minLatency").doubleValue();
+    mu = module->par("latencyMu").doubleValue();
+    sigma = module->par("latencySigma").doubleValue();
+    paretoShape = module->par("paretoShape").doubleValue();
+    paretoScale = module->par("paretoScale").doubleValue();
+    if (minLatency < 0 || sigma < 0 || paretoShape <= 0 || paretoScale <= 0) {
+        throw cRuntimeError("Invalid latency model parameters");
+    }
+    if (model == TRACE) {
+        loadTrace(module->par("latencyTrace").stdstringValue());
+    }
 
-    return delay;
+    int capacity = module->par("latencySamples").intValue();
+    if (capacity < 0) {
+        throw cRuntimeError("latencySamples must not be negative");
+    }
+    samples.setCapacity(capacity);
+    samples.clear();
+    refill();
 }
 
-LatencyGenerator::~LatencyGenerator() {
-    // TODO Auto-generated destructor stub
+void LatencyGenerator::attach(cModule* module, const char* gateName) {
+    bool vector = module->isGateVector(gateName);
+    int size = vector ? module->gateSize(gateName) : 1;
+    linkDelay = 0;
+    for (int i = 0; i < size; i++) {
+        cGate* gate = vector ? module->gate(gateName, i) : module->gate(gateName);
+        cDelayChannel* channel = dynamic_cast<cDelayChannel*>(gate->getChannel());
+        double delay = channel ? channel->getDelay().dbl() : 0;
+        linkDelay = i == 0 ? delay : min(linkDelay, delay);
+    }
+    double least = model == TRACE ? *min_element(trace.begin(), trace.end())
+            : minLatency;
+    if (linkDelay > least) {
+        throw cRuntimeError(module, "Channel delay %g s of gate '%s' exceeds "
+                "the least latency %g s", linkDelay, gateName, least);
+    }
 }
 
+simtime_t LatencyGenerator::draw() {
+    cRNG* r = rng ? rng : getEnvir()->getRNG(0);
+    switch (model) {
+    case CONSTANT:
+        return minLatency;
+    case LOGNORMAL:
+        // one-way half of the round-trip jitter
+        return minLatency + lognormal(r, mu, sigma) / 2 / 1000;
+    case PARETO:
+        return minLatency
+                + pareto_shifted(r, paretoShape, paretoScale, paretoScale);
+    case TRACE: {
+        double latency = trace[traceNext];
+        traceNext = (traceNext + 1) % trace.size();
+        return latency;
+    }
+    }
+    return minLatency;
+}
+
+void LatencyGenerator::refill() {
+    while (samples.getCapacity() && !samples.full()) {
+        samples.push_back(draw());
+    }
+}
+
+simtime_t LatencyGenerator::generator_latency() {
+    // the channel takes its delay out of the whole latency
+    if (!samples.getCapacity()) {
+        return draw() - linkDelay;
+    }
+    if (samples.empty()) {
+        refill();
+    }
+    simtime_t latency = samples.front();
+    samples.pop_front();
+    return latency - linkDelay;
+}
+
+LatencyGenerator::~LatencyGenerator() {
+}
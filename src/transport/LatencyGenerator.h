@@ -17,16 +17,76 @@
 #define TRANSPORT_LATENCYGENERATOR_H_
 
 #include <omnetpp.h>
+#include <string>
+#include <vector>
+#include "../common/RingBuffer.h"
 
 using namespace omnetpp;
 using namespace std;
 
+/*
+ * One-way link latency of a module's messages.
+ *
+ * Latencies are drawn ahead into a ring of samples, so that a message
+ * costs one load. The owner tops the ring up with refill() once it is done
+ * sending for an event; a ring that runs dry in a burst is refilled on
+ * the spot. The samples come out in the order they were drawn, so the
+ * sequence does not depend on when the ring is refilled.
+ *
+ * Over links with a delay channel, e.g. between the partitions of a
+ * parallel simulation where the channel delay is the lookahead, the
+ * channel takes part of each latency and the rest is sent delayed.
+ */
 class LatencyGenerator {
+public:
+    enum Model {
+        // minLatency only
+        CONSTANT,
+        // minLatency plus half a lognormal jitter in ms
+        LOGNORMAL,
+        // minLatency plus a Pareto tail starting at 0
+        PARETO,
+        // latencies in ms read from a file, replayed in a loop
+        TRACE
+    };
 private:
+    Model model;
+    cRNG* rng;
+    // in seconds
+    double minLatency;
+    // of the jitter in ms
+    double mu;
+    double sigma;
+    double paretoShape;
+    // in seconds
+    double paretoScale;
+    vector<double> trace;
+    size_t traceNext;
+    // taken by the channel, in seconds
+    double linkDelay;
+
+    // pregenerated whole latencies, empty without a capacity
+    RingBuffer<simtime_t> samples;
 
+    // a whole latency, the channel delay included
+    simtime_t draw();
+    void loadTrace(const string& filename);
 public:
     LatencyGenerator();
+    static bool parseModel(const string& name, Model& model);
+    /*
+     * Set up from the latency parameters of a module, see EventSource.ned,
+     * drawing from the module's RNG 0
+     */
+    void configure(cComponent* module);
+    /*
+     * Leave the least channel delay of the links of an output gate, or
+     * gate vector, to the channels. Throw if it exceeds the least latency.
+     */
+    void attach(cModule* module, const char* gateName);
     simtime_t generator_latency();
+    // draw the latencies handed out since the last refill
+    void refill();
     virtual ~LatencyGenerator();
 };
 
@@ -0,0 +1,337 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "SocketRTScheduler.h"
+
+Register_Class(SocketRTScheduler);
+
+Register_GlobalConfigOption(CFGID_SOCKETRTSCHEDULER_PORT,
+        "socketrtscheduler-port", CFG_INT, "4242",
+        "When SocketRTScheduler is selected as scheduler class: the port it receives IoT events on.");
+Register_GlobalConfigOption(CFGID_SOCKETRTSCHEDULER_PROTOCOL,
+        "socketrtscheduler-protocol", CFG_STRING, "udp",
+        "When SocketRTScheduler is selected as scheduler class: \"udp\", or \"tcp\" to accept one client at a time.");
+Register_GlobalConfigOption(CFGID_SOCKETRTSCHEDULER_SCALING,
+        "socketrtscheduler-scaling", CFG_DOUBLE, "1",
+        "When SocketRTScheduler is selected as scheduler class: wall-clock seconds per simulated second.");
+
+// longest wait between checks whether the user stopped the run
+static const int IDLE_CHECK_MS = 100;
+// largest UDP payload, a datagram is only read if it fits the buffer
+static const size_t MAX_DATAGRAM = 65507;
+// datagrams read by one recvmmsg
+static const size_t MAX_BATCH = 64;
+// lateness reported as behind the wall clock, events of one instant lag a bit
+static const double LATE_SECONDS = 0.01;
+
+SocketRTScheduler::SocketRTScheduler() {
+    scaling = 1;
+    port = 0;
+    tcp = false;
+    listenSocket = -1;
+    dataSocket = -1;
+    module = nullptr;
+    notificationMsg = nullptr;
+    buffer = nullptr;
+    capacity = 0;
+    numBytes = nullptr;
+    lag = 0;
+    maxLag = 0;
+    lateEvents = 0;
+}
+
+SocketRTScheduler::~SocketRTScheduler() {
+    closeSockets();
+}
+
+string SocketRTScheduler::str() const {
+    return string("socket real-time scheduler (") + (tcp ? "tcp" : "udp")
+            + " port " + to_string(port) + ")";
+}
+
+void SocketRTScheduler::setInterfaceModule(cModule* module,
+        cMessage* notificationMsg, char* buffer, size_t capacity,
+        size_t* numBytes) {
+    if (this->module) {
+        throw cRuntimeError("SocketRTScheduler: only one interface module is supported");
+    }
+    if (!tcp && capacity < MAX_DATAGRAM) {
+        throw cRuntimeError("SocketRTScheduler: a UDP receive buffer needs at least %d bytes",
+                (int) MAX_DATAGRAM);
+    }
+    this->module = module;
+    this->notificationMsg = notificationMsg;
+    this->buffer = buffer;
+    this->capacity = capacity;
+    this->numBytes = numBytes;
+}
+
+void SocketRTScheduler::startRun() {
+    cConfiguration* config = getEnvir()->getConfig();
+    port = config->getAsInt(CFGID_SOCKETRTSCHEDULER_PORT);
+    string protocol = config->getAsString(CFGID_SOCKETRTSCHEDULER_PROTOCOL);
+    if (protocol != "udp" && protocol != "tcp") {
+        throw cRuntimeError("SocketRTScheduler: unknown protocol '%s'",
+                protocol.c_str());
+    }
+    tcp = protocol == "tcp";
+    scaling = config->getAsDouble(CFGID_SOCKETRTSCHEDULER_SCALING);
+    if (scaling <= 0) {
+        throw cRuntimeError("SocketRTScheduler: scaling must be positive");
+    }
+    module = nullptr;
+    lag = 0;
+    maxLag = 0;
+    lateEvents = 0;
+    openSockets();
+    baseTime = Clock::now();
+}
+
+void SocketRTScheduler::endRun() {
+    closeSockets();
+    module = nullptr;
+    if (lateEvents > 0) {
+        EV_WARN << "SocketRTScheduler: " << lateEvents
+                << " events behind the wall clock, by up to " << maxLag
+                << " s" << endl;
+    }
+}
+
+void SocketRTScheduler::executionResumed() {
+    // continue from the current simulation time after a pause
+    baseTime = Clock::now()
+            - chrono::duration_cast<Clock::duration>(chrono::duration<double>(
+                    sim->getSimTime().dbl() * scaling));
+}
+
+void SocketRTScheduler::openSockets() {
+    int fd = socket(AF_INET, tcp ? SOCK_STREAM : SOCK_DGRAM, 0);
+    if (fd < 0) {
+        throw cRuntimeError("SocketRTScheduler: cannot create socket: %s",
+                strerror(errno));
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (::bind(fd, (sockaddr*) &addr, sizeof(addr)) < 0
+            || (tcp && listen(fd, 1) < 0)) {
+        int error = errno;
+        close(fd);
+        throw cRuntimeError("SocketRTScheduler: cannot bind port %d: %s",
+                port, strerror(error));
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    if (tcp) {
+        listenSocket = fd;
+    } else {
+        dataSocket = fd;
+    }
+}
+
+void SocketRTScheduler::closeSockets() {
+    if (dataSocket >= 0) {
+        close(dataSocket);
+        dataSocket = -1;
+    }
+    if (listenSocket >= 0) {
+        close(listenSocket);
+        listenSocket = -1;
+    }
+}
+
+SocketRTScheduler::Clock::time_point SocketRTScheduler::wallTimeOf(
+        simtime_t t) const {
+    return baseTime + chrono::duration_cast<Clock::duration>(
+            chrono::duration<double>(t.dbl() * scaling));
+}
+
+simtime_t SocketRTScheduler::simTimeOf(Clock::time_point wall) const {
+    return chrono::duration<double>(wall - baseTime).count() / scaling;
+}
+
+bool SocketRTScheduler::receive() {
+    if (!module || dataSocket < 0) {
+        return false;
+    }
+    size_t before = *numBytes;
+#ifdef __linux__
+    if (!tcp) {
+        receiveDatagrams();
+        return *numBytes > before;
+    }
+#endif
+    while (*numBytes < capacity) {
+        size_t space = capacity - *numBytes;
+        if (!tcp && space < MAX_DATAGRAM) {
+            break;
+        }
+        ssize_t n = recv(dataSocket, buffer + *numBytes, space, 0);
+        if (n > 0) {
+            *numBytes += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (tcp && (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))) {
+                // the client is gone, accept the next one
+                close(dataSocket);
+                dataSocket = -1;
+            }
+            break;
+        }
+    }
+    return *numBytes > before;
+}
+
+#ifdef __linux__
+void SocketRTScheduler::receiveDatagrams() {
+    mmsghdr msgs[MAX_BATCH];
+    iovec iov[MAX_BATCH];
+    while (true) {
+        // one slot of the largest datagram each
+        size_t slots = min((capacity - *numBytes) / MAX_DATAGRAM, MAX_BATCH);
+        if (slots == 0) {
+            return;
+        }
+        memset(msgs, 0, sizeof(mmsghdr) * slots);
+        for (size_t k = 0; k < slots; k++) {
+            iov[k].iov_base = buffer + *numBytes + k * MAX_DATAGRAM;
+            iov[k].iov_len = MAX_DATAGRAM;
+            msgs[k].msg_hdr.msg_iov = &iov[k];
+            msgs[k].msg_hdr.msg_iovlen = 1;
+        }
+        int n = recvmmsg(dataSocket, msgs, slots, MSG_DONTWAIT, nullptr);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return;
+        }
+        // pack the datagrams back to back
+        for (int k = 0; k < n; k++) {
+            memmove(buffer + *numBytes, iov[k].iov_base, msgs[k].msg_len);
+            *numBytes += msgs[k].msg_len;
+        }
+        if ((size_t) n < slots) {
+            return;
+        }
+    }
+}
+#endif
+
+void SocketRTScheduler::notify() {
+    if (!notificationMsg->isScheduled()) {
+        // never before the current event, nor after the next one
+        simtime_t t = max(simTimeOf(Clock::now()), sim->getSimTime());
+        cEvent* next = sim->getFES()->peekFirst();
+        if (next && next->getArrivalTime() < t) {
+            t = next->getArrivalTime();
+        }
+        notificationMsg->setArrival(module->getId(), -1, t);
+        sim->getFES()->insert(notificationMsg);
+    }
+}
+
+bool SocketRTScheduler::receiveUntil(Clock::time_point target) {
+    while (true) {
+        Clock::time_point now = Clock::now();
+        if (now >= target) {
+            return true;
+        }
+        int timeout = min<int64_t>(IDLE_CHECK_MS,
+                chrono::duration_cast<chrono::milliseconds>(target - now).count() + 1);
+
+        pollfd fds[2];
+        int count = 0;
+        bool full = !module || *numBytes >= capacity
+                || (!tcp && capacity - *numBytes < MAX_DATAGRAM);
+        if (dataSocket >= 0 && !full) {
+            fds[count].fd = dataSocket;
+            fds[count++].events = POLLIN;
+        }
+        if (listenSocket >= 0 && dataSocket < 0) {
+            fds[count].fd = listenSocket;
+            fds[count++].events = POLLIN;
+        }
+        int ready = poll(fds, count, timeout);
+        if (ready > 0) {
+            if (listenSocket >= 0 && dataSocket < 0) {
+                int client = accept(listenSocket, nullptr, nullptr);
+                if (client >= 0) {
+                    fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+                    dataSocket = client;
+                }
+            } else if (receive()) {
+                notify();
+                return true;
+            }
+        } else if (getEnvir()->idle()) {
+            return false;
+        }
+    }
+}
+
+cEvent* SocketRTScheduler::guessNextEvent() {
+    return sim->getFES()->peekFirst();
+}
+
+cEvent* SocketRTScheduler::takeNextEvent() {
+    while (true) {
+        cEvent* event = sim->getFES()->peekFirst();
+        Clock::time_point target = event ? wallTimeOf(event->getArrivalTime())
+                : Clock::time_point::max();
+        Clock::time_point now = Clock::now();
+        if (now < target) {
+            if (!receiveUntil(target)) {
+                return nullptr;
+            }
+            if (sim->getFES()->peekFirst() != event || Clock::now() < target) {
+                // data arrived first, or wait again
+                continue;
+            }
+            lag = 0;
+        } else {
+            // behind the wall clock, but still pick up waiting data
+            if (receive()) {
+                notify();
+                if (sim->getFES()->peekFirst() != event) {
+                    continue;
+                }
+            }
+            lag = chrono::duration<double>(now - target).count();
+            if (lag > LATE_SECONDS) {
+                maxLag = max(maxLag, lag);
+                lateEvents++;
+            }
+        }
+        return sim->getFES()->removeFirst();
+    }
+}
+
+void SocketRTScheduler::putBackEvent(cEvent* event) {
+    sim->getFES()->putBackFirst(event);
+}
@@ -0,0 +1,107 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#ifndef TRANSPORT_SOCKETRTSCHEDULER_H_
+#define TRANSPORT_SOCKETRTSCHEDULER_H_
+
+#include <omnetpp.h>
+#include <chrono>
+
+using namespace omnetpp;
+using namespace std;
+
+/*
+ * Real-time scheduler for live devices: events are executed when the
+ * wall clock reaches their simulation time, and while waiting for the
+ * next one, data arriving on a UDP port, or from one TCP client at a
+ * time, is read without blocking into the buffer of a single interface
+ * module. Everything available is read at once, on Linux up to 64
+ * datagrams per recvmmsg packed back to back, and the module is
+ * notified with one message per batch. While the notification is
+ * pending, more data is appended to the buffer until it is full.
+ *
+ * Select it with scheduler-class = "SocketRTScheduler", see the
+ * socketrtscheduler-* options. Events that are taken behind the wall
+ * clock are executed at once, and their lateness is kept in getLag().
+ */
+class SocketRTScheduler: public cScheduler {
+private:
+    typedef chrono::steady_clock Clock;
+
+    // wall-clock time of simulation time 0
+    Clock::time_point baseTime;
+    // wall-clock seconds per simulation second
+    double scaling;
+    int port;
+    bool tcp;
+    // TCP listener, and the UDP socket or the connected TCP client
+    int listenSocket;
+    int dataSocket;
+
+    // interface module and its receive buffer
+    cModule* module;
+    cMessage* notificationMsg;
+    char* buffer;
+    size_t capacity;
+    size_t* numBytes;
+
+    // wall-clock lateness of the last event taken, in seconds
+    double lag;
+    double maxLag;
+    long lateEvents;
+
+    Clock::time_point wallTimeOf(simtime_t t) const;
+    simtime_t simTimeOf(Clock::time_point wall) const;
+    void openSockets();
+    void closeSockets();
+    // read whatever is available, true if the buffer grew
+    bool receive();
+#ifdef __linux__
+    // many datagrams per system call
+    void receiveDatagrams();
+#endif
+    // wait for data until the target, false if the user stopped the run
+    bool receiveUntil(Clock::time_point target);
+    void notify();
+public:
+    SocketRTScheduler();
+    virtual ~SocketRTScheduler();
+    virtual string str() const override;
+
+    virtual void startRun() override;
+    virtual void endRun() override;
+    virtual void executionResumed() override;
+
+    /*
+     * Register the module that receives the data. Bytes are appended to
+     * buffer at offset *numBytes; the module consumes them when it gets
+     * notificationMsg and updates *numBytes.
+     */
+    void setInterfaceModule(cModule* module, cMessage* notificationMsg,
+            char* buffer, size_t capacity, size_t* numBytes);
+
+    virtual cEvent* guessNextEvent() override;
+    virtual cEvent* takeNextEvent() override;
+    virtual void putBackEvent(cEvent* event) override;
+
+    double getLag() const {
+        return lag;
+    }
+    double getScaling() const {
+        return scaling;
+    }
+};
+
+#endif /* TRANSPORT_SOCKETRTSCHEDULER_H_ */
@@ -0,0 +1,221 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+/*
+ * sgbench: drive the reasoning pipeline on a model, outside the simulation
+ * kernel, and report its cost per stage.
+ *
+ *   sgbench [-r auto|bitset|interval] [-t slices] [-f] [-e] [-j threads]
+ *           [-m boolean|weighted] model.json
+ *
+ * Each slice runs SituationArranger::arrange for the six 0.5 s event ticks
+ * of a 3 s slice, caches the triggering operations, then runs
+ * SituationReasoner::reason and OperationGenerator::generateOperations,
+ * as the EventSource and Synchronizer modules do. -e arranges only at
+ * the due times of the slice, as an event-driven EventSource. -f uses
+ * a SweepEngine instead of an IncrementalEngine, -j sweeps its layers on
+ * that many threads, 0 for one per hardware thread. Times are wall-clock;
+ * the model is loaded from JSON, never from an image, so that the load
+ * time is comparable.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../src/common/SliceArena.h"
+#include "../src/objects/IncrementalEngine.h"
+#include "../src/objects/OperationGenerator.h"
+#include "../src/objects/SituationArranger.h"
+#include "../src/objects/SituationReasoner.h"
+#include "../src/objects/SweepEngine.h"
+#include "../src/objects/TriggerBuffer.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static double since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// per-call latencies of one stage
+struct Stage {
+    const char* name;
+    vector<double> samples;
+    double total = 0;
+
+    Stage(const char* name) : name(name) {}
+
+    void add(double seconds) {
+        samples.push_back(seconds);
+        total += seconds;
+    }
+
+    double percentile(double p) {
+        if (samples.empty()) {
+            return 0;
+        }
+        size_t k = min(samples.size() - 1, (size_t) (p * samples.size()));
+        nth_element(samples.begin(), samples.begin() + k, samples.end());
+        return samples[k];
+    }
+
+    void report() {
+        size_t n = samples.size();
+        printf("%-10s %8zu calls  mean %10.3f us  p50 %10.3f us  "
+                "p99 %10.3f us  max %10.3f us\n", name, n,
+                n ? total / n * 1e6 : 0, percentile(0.5) * 1e6,
+                percentile(0.99) * 1e6,
+                n ? *max_element(samples.begin(), samples.end()) * 1e6 : 0);
+    }
+};
+
+static int usage() {
+    fprintf(stderr,
+            "usage: sgbench [-r auto|bitset|interval] [-t slices] [-f] "
+            "[-e] [-j threads] [-m boolean|weighted] model.json\n");
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    ReachabilityIndex::Strategy strategy = ReachabilityIndex::AUTO;
+    int slices = 100;
+    bool incremental = true;
+    int threads = 1;
+    ReasoningEngine::Mode mode = ReasoningEngine::BOOLEAN;
+    bool eventDriven = false;
+    string modelFile;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            if (!ReachabilityIndex::parseStrategy(argv[++i], strategy)) {
+                fprintf(stderr, "sgbench: unknown reachability index '%s'\n",
+                        argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            slices = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-f") == 0) {
+            incremental = false;
+        } else if (strcmp(argv[i], "-e") == 0) {
+            eventDriven = true;
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            if (!ReasoningEngine::parseMode(argv[++i], mode)) {
+                fprintf(stderr, "sgbench: unknown reasoning mode '%s'\n",
+                        argv[i]);
+                return 2;
+            }
+        } else if (argv[i][0] == '-' || !modelFile.empty()) {
+            return usage();
+        } else {
+            modelFile = argv[i];
+        }
+    }
+    if (modelFile.empty() || slices <= 0) {
+        return usage();
+    }
+
+    // as simtime-resolution in omnetpp.ini
+    SimTime::setScaleExp(-3);
+
+    SituationArranger sa;
+    SituationReasoner sr;
+    OperationGenerator sog;
+    Clock::time_point start = Clock::now();
+    try {
+        sr.initModel(modelFile.c_str(), strategy, false);
+    } catch (exception& e) {
+        fprintf(stderr, "sgbench: cannot load '%s': %s\n", modelFile.c_str(),
+                e.what());
+        return 1;
+    }
+    double loadTime = since(start);
+    // the registry hands the same model to the arranger
+    sa.initModel(modelFile.c_str(), strategy, false);
+    if (incremental) {
+        sr.setEngine(unique_ptr<ReasoningEngine>(new IncrementalEngine(mode)));
+    } else {
+        sr.setEngine(unique_ptr<ReasoningEngine>(
+                new SweepEngine(mode, threads)));
+    }
+    sa.setEventDriven(eventDriven, 0.5);
+    sog.setModel(sr.getModel());
+    sog.setModelInstance(&sr);
+
+    const SituationGraph& model = *sr.getModel();
+    printf("%s: %d situations, %d layers, %s reasoning\n", modelFile.c_str(),
+            model.numNodes(), model.modelHeight(),
+            incremental ? "incremental" : "full");
+    printf("%-10s %10.3f ms\n", "load", loadTime * 1e3);
+
+    Stage arrange("arrange"), cache("cache"), reason("reason"),
+            generate("generate");
+    TriggerBuffer triggers;
+    triggers.setModel(sr.getModel());
+    sog.setTriggerBuffer(&triggers);
+    long events = 0, operations = 0;
+    Clock::time_point run = Clock::now();
+    SliceArena arena;
+    for (int s = 1; s <= slices; s++) {
+        arena.reset();
+        simtime_t current = s * 3;
+        simtime_t due = current - 3;
+        while (eventDriven ? sa.nextDue(due) && due <= current
+                : (due += 0.5) <= current) {
+            start = Clock::now();
+            vector<PhysicalOperation> physical = sa.arrange(due);
+            arrange.add(since(start));
+
+            start = Clock::now();
+            for (auto& op : physical) {
+                if (op.toTrigger && sog.cacheEvent(op.id, true, op.getTimestamp())) {
+                    events++;
+                }
+            }
+            cache.add(since(start));
+            sr.checkState(due);
+        }
+
+        Span<int> triggered = triggers.drain();
+        start = Clock::now();
+        SituationSet tOperations = sr.reason(triggered, current, arena.get());
+        reason.add(since(start));
+
+        start = Clock::now();
+        OperationSets opSets(arena.get());
+        sog.generateOperations(tOperations, opSets);
+        generate.add(since(start));
+        for (auto& operationSet : opSets) {
+            operations += operationSet.size();
+        }
+    }
+    double runTime = since(run);
+
+    arrange.report();
+    cache.report();
+    reason.report();
+    generate.report();
+    printf("%d slices in %.3f s: %.1f slices/s, %.0f events/s, "
+            "%ld operations\n", slices, runTime, slices / runTime,
+            events / runTime, operations);
+    return 0;
+}
@@ -0,0 +1,172 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+/*
+ * sgcheck: consistency checks of the reasoning pipeline on a model,
+ * outside the simulation kernel.
+ *
+ *   sgcheck model.json
+ *
+ * Each check drives a SituationReasoner, an OperationGenerator and a
+ * TriggerBuffer through a few slices, as the Synchronizer does, and
+ * prints FAIL with what went wrong. The exit code is the number of
+ * failed checks.
+ */
+
+#include <cstdio>
+#include <exception>
+#include <string>
+#include "../src/common/SliceArena.h"
+#include "../src/objects/IncrementalEngine.h"
+#include "../src/objects/OperationGenerator.h"
+#include "../src/objects/SituationReasoner.h"
+#include "../src/objects/TriggerBuffer.h"
+
+using namespace std;
+
+static string modelFile;
+
+// the pipeline of one Synchronizer
+struct Pipeline {
+    SituationReasoner sr;
+    OperationGenerator sog;
+    TriggerBuffer triggers;
+    SliceArena arena;
+
+    explicit Pipeline(OperationGenerator::MergePolicy merge) {
+        sr.initModel(modelFile.c_str(), ReachabilityIndex::AUTO, false);
+        sr.setEngine(unique_ptr<ReasoningEngine>(new IncrementalEngine()));
+        sog.setModel(sr.getModel());
+        sog.setModelInstance(&sr);
+        triggers.setModel(sr.getModel());
+        sog.setTriggerBuffer(&triggers);
+        sog.setMergePolicy(merge);
+    }
+
+    // one slice at current, true if an operation of id was generated
+    bool slice(simtime_t current, long id, size_t& drained) {
+        arena.reset();
+        Span<int> triggered = triggers.drain();
+        drained = triggered.size();
+        SituationSet tOperations = sr.reason(triggered, current, arena.get());
+        OperationSets opSets(arena.get());
+        sog.generateOperations(tOperations, opSets);
+        for (auto& operations : opSets) {
+            for (auto& op : operations) {
+                if (op.id == id) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+static int failures = 0;
+
+static void check(bool condition, const char* name, const char* what) {
+    if (!condition) {
+        printf("FAIL %s: %s\n", name, what);
+        failures++;
+    }
+}
+
+// an operational situation of the model
+static long bottomOf(const SituationGraph& model) {
+    return model.idAt(model.getLayerIndices(model.modelHeight() - 1)[0]);
+}
+
+/*
+ * A queue drained by the merge in one slice leaves no trigger behind, so
+ * the situation does not fire again, nor is it compensated, in the next.
+ */
+static void checkDrainMerge() {
+    const char* name = "drain merge";
+    Pipeline p(OperationGenerator::LAST_WRITER_WINS);
+    long id = bottomOf(*p.sr.getModel());
+    p.sog.cacheEvent(id, true, 0.5);
+    p.sog.cacheEvent(id, true, 1);
+    p.sog.cacheEvent(id, true, 1.5);
+    check(p.triggers.size() == 1, name, "one trigger for a drained queue");
+    size_t drained;
+    check(p.slice(3, id, drained), name, "no operation in the first slice");
+    check(drained == 1, name, "not triggered in the first slice");
+    check(p.triggers.empty(), name, "triggers left after the merge");
+    check(!p.slice(6, id, drained), name, "operation in the next slice");
+    check(drained == 0, name, "triggered again in the next slice");
+}
+
+// each event cached with FIRST fires in a slice of its own, and no more
+static void checkFirst() {
+    const char* name = "first";
+    Pipeline p(OperationGenerator::FIRST);
+    long id = bottomOf(*p.sr.getModel());
+    p.sog.cacheEvent(id, true, 0.5);
+    p.sog.cacheEvent(id, true, 1);
+    size_t drained;
+    check(p.slice(3, id, drained), name, "no operation in the first slice");
+    check(p.slice(6, id, drained), name, "no operation in the second slice");
+    check(p.triggers.empty(), name, "triggers left after both events");
+    check(!p.slice(9, id, drained), name, "operation in the third slice");
+    check(drained == 0, name, "triggered again in the third slice");
+}
+
+/*
+ * A trigger cancelled by a release never fires, and releases left over
+ * are not sent on their own.
+ */
+static void checkToggleCancel() {
+    const char* name = "toggle cancel";
+    Pipeline p(OperationGenerator::TOGGLE_CANCEL);
+    long id = bottomOf(*p.sr.getModel());
+    p.sog.cacheEvent(id, true, 0.5);
+    p.sog.cacheEvent(id, false, 1);
+    check(p.triggers.empty(), name, "trigger left after its release");
+    size_t drained;
+    check(!p.slice(3, id, drained), name, "operation for a cancelled pair");
+    check(drained == 0, name, "triggered by a cancelled pair");
+
+    // releases with no trigger to cancel are not sent either
+    p.sog.cacheEvent(id, false, 3.5);
+    check(!p.slice(6, id, drained), name, "operation for a lone release");
+    p.sog.cacheEvent(id, true, 6.5);
+    p.sog.cacheEvent(id, false, 7);
+    p.sog.cacheEvent(id, false, 7.5);
+    check(p.triggers.empty(), name, "trigger left after two releases");
+    check(!p.slice(9, id, drained), name,
+            "operation for trigger, release, release");
+    check(drained == 0, name, "triggered by trigger, release, release");
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: sgcheck model.json\n");
+        return 2;
+    }
+    modelFile = argv[1];
+    // as simtime-resolution in omnetpp.ini
+    SimTime::setScaleExp(-3);
+
+    try {
+        checkDrainMerge();
+        checkFirst();
+        checkToggleCancel();
+    } catch (exception& e) {
+        fprintf(stderr, "sgcheck: %s\n", e.what());
+        return 1;
+    }
+    printf("%d checks failed\n", failures);
+    return failures;
+}
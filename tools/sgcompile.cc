@@ -0,0 +1,180 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+/*
+ * sgcompile: compile a JSON situation model into a binary model image.
+ *
+ *   sgcompile [-r auto|bitset|interval] [-o image] model.json
+ *   sgcompile -e engine.cc model.json
+ *
+ * The image is written to model.json.sgb by default, where the simulation
+ * picks it up as long as the JSON file is unchanged. The index strategy
+ * must match the reachabilityIndex parameter of the modules.
+ *
+ * With -e, a reasoning engine specialized to the model is generated
+ * instead, see CompiledEngine.h. The source belongs in a directory right
+ * below src, e.g. src/engines, to be built into the simulation, where
+ * reasoningEngine = "compiled" selects it for this model.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+#include "../src/objects/ModelImage.h"
+#include "../src/objects/SituationGraph.h"
+
+using namespace std;
+
+static int usage() {
+    fprintf(stderr,
+            "usage: sgcompile [-r auto|bitset|interval] [-o image] model.json\n"
+            "       sgcompile -e engine.cc model.json\n");
+    return 2;
+}
+
+// one constexpr array, with an unused element if empty
+template <typename T>
+static void writeArray(FILE* f, const char* type, const char* name,
+        const vector<T>& values) {
+    fprintf(f, "    static constexpr %s %s[] = {", type, name);
+    if (values.empty()) {
+        fprintf(f, " 0 };\n");
+        return;
+    }
+    for (size_t i = 0; i < values.size(); i++) {
+        fprintf(f, "%s%s%ld", i == 0 ? "" : ",", i % 12 == 0 ? "\n        " : " ",
+                (long) values[i]);
+    }
+    fprintf(f, " };\n");
+}
+
+static bool writeEngine(const SituationGraph& model, const string& modelFile,
+        const string& engineFile) {
+    vector<long> ids;
+    for (int i = 0; i < model.numNodes(); i++) {
+        ids.push_back(model.idAt(i));
+    }
+    // upper layers in layer order, AND and SOLE evidences before OR
+    vector<int> layerSlots;
+    vector<int> slotNodes;
+    vector<int> edgeOffsets(1, 0);
+    vector<int> orStarts;
+    vector<int> sources;
+    for (int l = 0; l < model.modelHeight() - 1; l++) {
+        layerSlots.push_back(slotNodes.size());
+        for (auto index : model.getLayerIndices(l)) {
+            slotNodes.push_back(index);
+            Span<int> evidences = model.getEvidences(index);
+            Span<char> relations = model.getEvidenceRelations(index);
+            for (int pass = 0; pass < 2; pass++) {
+                if (pass == 1) {
+                    orStarts.push_back(sources.size());
+                }
+                for (size_t e = 0; e < evidences.size(); e++) {
+                    if ((relations[e] == SituationRelation::OR) == (pass == 1)) {
+                        sources.push_back(evidences[e]);
+                    }
+                }
+            }
+            edgeOffsets.push_back(sources.size());
+        }
+    }
+    layerSlots.push_back(slotNodes.size());
+
+    FILE* f = fopen(engineFile.c_str(), "w");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "// Generated by sgcompile -e from %s, do not edit.\n\n",
+            modelFile.c_str());
+    fprintf(f, "#include \"../objects/CompiledEngine.h\"\n\n");
+    fprintf(f, "namespace {\n\nstruct Model {\n");
+    fprintf(f, "    static constexpr int NODES = %d;\n", model.numNodes());
+    fprintf(f, "    static constexpr int HEIGHT = %d;\n", model.modelHeight());
+    fprintf(f, "    static constexpr int UPPER = %d;\n", (int) slotNodes.size());
+    writeArray(f, "long", "ids", ids);
+    writeArray(f, "int", "layerSlots", layerSlots);
+    writeArray(f, "int", "slotNodes", slotNodes);
+    writeArray(f, "int", "edgeOffsets", edgeOffsets);
+    writeArray(f, "int", "orStarts", orStarts);
+    writeArray(f, "int", "sources", sources);
+    fprintf(f, "};\n\ntypedef CompiledEngine<Model> ModelEngine;\n"
+            "Register_ReasoningEngine(ModelEngine);\n\n}\n");
+    return fclose(f) == 0;
+}
+
+int main(int argc, char** argv) {
+    ReachabilityIndex::Strategy strategy = ReachabilityIndex::AUTO;
+    string modelFile;
+    string imageFile;
+    string engineFile;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            if (!ReachabilityIndex::parseStrategy(argv[++i], strategy)) {
+                fprintf(stderr, "sgcompile: unknown reachability index '%s'\n",
+                        argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            imageFile = argv[++i];
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            engineFile = argv[++i];
+        } else if (argv[i][0] == '-' || !modelFile.empty()) {
+            return usage();
+        } else {
+            modelFile = argv[i];
+        }
+    }
+    if (modelFile.empty()) {
+        return usage();
+    }
+    if (imageFile.empty()) {
+        imageFile = ModelImage::imagePath(modelFile);
+    }
+
+    SituationGraph model;
+    try {
+        model.loadModel(modelFile, strategy);
+    } catch (exception& e) {
+        fprintf(stderr, "sgcompile: cannot load '%s': %s\n", modelFile.c_str(),
+                e.what());
+        return 1;
+    }
+    if (!engineFile.empty()) {
+        if (!writeEngine(model, modelFile, engineFile)) {
+            fprintf(stderr, "sgcompile: cannot write '%s'\n",
+                    engineFile.c_str());
+            return 1;
+        }
+        printf("%s: %d situations, %d layers -> %s\n", modelFile.c_str(),
+                model.numNodes(), model.modelHeight(), engineFile.c_str());
+        return 0;
+    }
+    if (!ModelImage::write(model, modelFile, imageFile, strategy)) {
+        fprintf(stderr, "sgcompile: cannot write '%s'\n", imageFile.c_str());
+        return 1;
+    }
+    if (!ModelImage::load(modelFile, imageFile, strategy)) {
+        fprintf(stderr, "sgcompile: '%s' does not read back\n",
+                imageFile.c_str());
+        return 1;
+    }
+    printf("%s: %d situations, %d layers -> %s\n", modelFile.c_str(),
+            model.numNodes(), model.modelHeight(), imageFile.c_str());
+    return 0;
+}
@@ -0,0 +1,223 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+/*
+ * sggen: generate a random layered situation model in the SG.json format.
+ *
+ *   sggen [-n nodes] [-l layers] [-f fanout] [-i fanin] [-b backedges]
+ *         [-d duration] [-c cycle] [-s seed] [-o model.json]
+ *
+ * The nodes are spread evenly over the layers, layer 0 being the top one
+ * and the last one holding the operational situations. Every node but the
+ * bottom ones has 1..fanout evidences in the layer below, and 0..fanin
+ * causes among the nodes before it in its own layer. With probability
+ * backedges (0..1) a node also gets a cause after it, which closes a
+ * cycle. Durations and cycles are drawn in steps of 500 ms, the event tick,
+ * up to the given maximum in milliseconds; bottom cycles are at least one
+ * tick.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int usage() {
+    fprintf(stderr,
+            "usage: sggen [-n nodes] [-l layers] [-f fanout] [-i fanin] "
+            "[-b backedges]\n"
+            "             [-d duration] [-c cycle] [-s seed] [-o model.json]\n");
+    return 2;
+}
+
+struct Options {
+    long nodes = 100;
+    int layers = 3;
+    int fanout = 2;
+    int fanin = 1;
+    double backedges = 0;
+    long duration = 3000;
+    long cycle = 3000;
+    unsigned long seed = 1;
+    string output;
+};
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' || argv[i][1] == 0 || argv[i][2] != 0
+                || i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        switch (argv[i - 1][1]) {
+        case 'n':
+            options.nodes = atol(value);
+            break;
+        case 'l':
+            options.layers = atoi(value);
+            break;
+        case 'f':
+            options.fanout = atoi(value);
+            break;
+        case 'i':
+            options.fanin = atoi(value);
+            break;
+        case 'b':
+            options.backedges = atof(value);
+            break;
+        case 'd':
+            options.duration = atol(value);
+            break;
+        case 'c':
+            options.cycle = atol(value);
+            break;
+        case 's':
+            options.seed = strtoul(value, nullptr, 10);
+            break;
+        case 'o':
+            options.output = value;
+            break;
+        default:
+            return false;
+        }
+    }
+    return options.layers >= 1 && options.nodes >= options.layers
+            && options.fanout >= 1 && options.fanin >= 0
+            && options.backedges >= 0 && options.backedges <= 1
+            && options.duration >= 0 && options.cycle >= 0;
+}
+
+// a step of 500 ms in [0, max]
+static long drawTime(mt19937_64& rng, long max) {
+    return uniform_int_distribution<long>(0, max / 500)(rng) * 500;
+}
+
+// 0 sole, 1 and, 2 or
+static int drawRelation(mt19937_64& rng, size_t count) {
+    return count > 1 ? uniform_int_distribution<int>(1, 2)(rng) : 0;
+}
+
+static void writeRelations(FILE* out, const char* key, const char* weight,
+        const vector<long>& ids, int relation) {
+    fprintf(out, "\"%s\": ", key);
+    if (ids.empty()) {
+        fprintf(out, "null");
+        return;
+    }
+    fprintf(out, "[");
+    for (size_t k = 0; k < ids.size(); k++) {
+        fprintf(out, "%s{\"ID\": %ld, \"%s\": 0.98, \"Relation\": %d}",
+                k ? "," : "", ids[k], weight, relation);
+    }
+    fprintf(out, "]");
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return usage();
+    }
+    FILE* out = options.output.empty() ? stdout
+            : fopen(options.output.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "sggen: cannot write '%s'\n", options.output.c_str());
+        return 1;
+    }
+
+    mt19937_64 rng(options.seed);
+    uniform_real_distribution<double> unit(0, 1);
+
+    // layer l holds width(l) nodes with IDs base * (l + 1) + position
+    long width = options.nodes / options.layers;
+    long base = 10;
+    while (base <= options.nodes) {
+        base *= 10;
+    }
+    auto widthOf = [&](int l) {
+        return l == options.layers - 1 ?
+                options.nodes - width * (options.layers - 1) : width;
+    };
+
+    fprintf(out, "{\n\"layers\": [\n");
+    vector<long> causes;
+    vector<long> evidences;
+    for (int l = 0; l < options.layers; l++) {
+        long size = widthOf(l);
+        fprintf(out, "%s[\n", l ? ",\n" : "");
+        for (long p = 0; p < size; p++) {
+            long id = base * (l + 1) + p;
+
+            causes.clear();
+            if (p > 0 && options.fanin > 0) {
+                int count = uniform_int_distribution<int>(0, options.fanin)(rng);
+                for (int k = 0; k < count; k++) {
+                    causes.push_back(base * (l + 1)
+                            + uniform_int_distribution<long>(0, p - 1)(rng));
+                }
+            }
+            if (p + 1 < size && unit(rng) < options.backedges) {
+                causes.push_back(base * (l + 1)
+                        + uniform_int_distribution<long>(p + 1, size - 1)(rng));
+            }
+            sort(causes.begin(), causes.end());
+            causes.erase(unique(causes.begin(), causes.end()), causes.end());
+
+            evidences.clear();
+            if (l + 1 < options.layers) {
+                long below = widthOf(l + 1);
+                int count = uniform_int_distribution<int>(1, options.fanout)(rng);
+                // evidences around the same relative position, for locality
+                long center = p * below / size;
+                long spread = options.fanout * 2;
+                long low = max(0L, center - spread);
+                long high = min(below - 1, center + spread);
+                for (int k = 0; k < count; k++) {
+                    evidences.push_back(base * (l + 2)
+                            + uniform_int_distribution<long>(low, high)(rng));
+                }
+                sort(evidences.begin(), evidences.end());
+                evidences.erase(unique(evidences.begin(), evidences.end()),
+                        evidences.end());
+            }
+
+            fprintf(out, "%s{\"ID\": %ld, ", p ? ",\n" : "", id);
+            writeRelations(out, "Predecessors", "Weight-x", causes,
+                    drawRelation(rng, causes.size()));
+            fprintf(out, ", ");
+            writeRelations(out, "Children", "Weight-y", evidences,
+                    drawRelation(rng, evidences.size()));
+            // operational situations are sampled every cycle, which can't be 0
+            long cycle = drawTime(rng, options.cycle);
+            if (l + 1 == options.layers && cycle == 0) {
+                cycle = 500;
+            }
+            fprintf(out, ", \"Duration\": %ld, \"Cycle\": %ld}",
+                    drawTime(rng, options.duration), cycle);
+        }
+        fprintf(out, "\n]");
+    }
+    fprintf(out, "\n]\n}\n");
+
+    if (out != stdout && fclose(out) != 0) {
+        fprintf(stderr, "sggen: cannot write '%s'\n", options.output.c_str());
+        return 1;
+    }
+    return 0;
+}
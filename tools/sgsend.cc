@@ -0,0 +1,142 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+/*
+ * sgsend: send IoT events to a live synchronizer in the binary WireFormat.
+ *
+ *   sgsend [-h host] [-p port] [-T] [-n records] < events.txt
+ *
+ * Events are read as lines "<eventID> <toTrigger> [<timestamp>]", the
+ * timestamp in seconds, and sent in frames of up to records events
+ * (default 1000), one UDP datagram per frame, or over a TCP connection
+ * with -T. See [Config Live] in omnetpp.ini for the receiving side.
+ */
+
+#include <arpa/inet.h>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#include "../src/common/WireFormat.h"
+
+using namespace std;
+
+static int usage() {
+    fprintf(stderr,
+            "usage: sgsend [-h host] [-p port] [-T] [-n records] < events.txt\n");
+    return 2;
+}
+
+static bool sendAll(int fd, const vector<char>& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, 0);
+        if (n < 0) {
+            return false;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* host = "127.0.0.1";
+    const char* port = "4242";
+    bool tcp = false;
+    size_t perFrame = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 && i + 1 < argc) {
+            host = argv[++i];
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            port = argv[++i];
+        } else if (strcmp(argv[i], "-T") == 0) {
+            tcp = true;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            perFrame = atoi(argv[++i]);
+        } else {
+            return usage();
+        }
+    }
+    if (perFrame == 0 || perFrame > WireFormat::MAX_RECORDS) {
+        fprintf(stderr, "sgsend: records per frame must be 1..%u\n",
+                WireFormat::MAX_RECORDS);
+        return 2;
+    }
+
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = tcp ? SOCK_STREAM : SOCK_DGRAM;
+    addrinfo* addr = nullptr;
+    if (getaddrinfo(host, port, &hints, &addr) != 0) {
+        fprintf(stderr, "sgsend: cannot resolve %s:%s\n", host, port);
+        return 1;
+    }
+    int fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (fd < 0 || connect(fd, addr->ai_addr, addr->ai_addrlen) < 0) {
+        fprintf(stderr, "sgsend: cannot connect to %s:%s\n", host, port);
+        freeaddrinfo(addr);
+        return 1;
+    }
+    freeaddrinfo(addr);
+
+    vector<WireFormat::Record> records;
+    vector<char> frame;
+    long sent = 0, skipped = 0;
+    char line[256];
+    bool ok = true;
+    while (ok) {
+        bool more = fgets(line, sizeof(line), stdin) != nullptr;
+        if (more) {
+            long id;
+            int toTrigger;
+            double timestamp = 0;
+            int fields = sscanf(line, "%ld %d %lf", &id, &toTrigger, &timestamp);
+            if (fields < 2) {
+                skipped++;
+                continue;
+            }
+            WireFormat::Record record;
+            memset(&record, 0, sizeof(record));
+            record.eventID = id;
+            record.toTrigger = toTrigger != 0;
+            record.timestamp = llround(timestamp * 1e6);
+            records.push_back(record);
+        }
+        if (!records.empty() && (!more || records.size() == perFrame)) {
+            frame.clear();
+            WireFormat::encode(frame, records.data(), records.size());
+            ok = sendAll(fd, frame);
+            sent += records.size();
+            records.clear();
+        }
+        if (!more) {
+            break;
+        }
+    }
+    close(fd);
+    if (!ok) {
+        fprintf(stderr, "sgsend: send failed after %ld events\n", sent);
+        return 1;
+    }
+    fprintf(stderr, "sgsend: %ld events sent, %ld lines skipped\n", sent,
+            skipped);
+    return 0;
+}
@@ -0,0 +1,72 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+//
+
+/*
+ * sgtrace: print a binary synchronizer trace as CSV.
+ *
+ *   sgtrace trace.bin
+ *
+ * The trace is written by the Synchronizer if its traceFile parameter
+ * is set. Columns are time, type, id, timestamp and value.
+ */
+
+#include <cstdio>
+#include "../src/common/TraceSink.h"
+
+using namespace std;
+
+static const char* typeName(int32_t type) {
+    switch (type) {
+    case TraceSink::IOT_EVENT:
+        return "iot";
+    case TraceSink::SLICE:
+        return "slice";
+    case TraceSink::TRIGGERED:
+        return "triggered";
+    case TraceSink::SIM_EVENT:
+        return "sim";
+    default:
+        return "unknown";
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: sgtrace trace.bin\n");
+        return 2;
+    }
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        fprintf(stderr, "sgtrace: cannot open '%s'\n", argv[1]);
+        return 1;
+    }
+    TraceSink::TraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1
+            || !TraceSink::checkHeader(header)) {
+        fprintf(stderr, "sgtrace: '%s' is not a trace of this version\n",
+                argv[1]);
+        fclose(file);
+        return 1;
+    }
+
+    printf("time,type,id,timestamp,value\n");
+    TraceSink::Record record;
+    while (fread(&record, sizeof(record), 1, file) == 1) {
+        printf("%.9g,%s,%lld,%.9g,%d\n", record.time, typeName(record.type),
+                (long long) record.id, record.timestamp, record.value);
+    }
+    fclose(file);
+    return 0;
+}